@@ -0,0 +1,45 @@
+#include "../Source/BatchRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Measures how runBatch scales with worker threads: the same batch of
+// identical-cost runs is timed at 1, 2, 4, ... threads. With independent runs
+// and one world per worker, `efficiency` (speedup / threads) should stay close
+// to 1 up to the number of physical cores.
+int main(int argc, char* argv[]) {
+    unsigned int maxThreads = argc >= 2 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    const int numRuns = argc >= 3 ? std::atoi(argv[2]) : 64;
+    const int steps = argc >= 4 ? std::atoi(argv[3]) : 600;
+
+    std::vector<BatchRun> runs(numRuns);
+    for (int i = 0; i < numRuns; ++i) {
+        runs[i].index = i;
+        runs[i].params.seed = i + 1;
+        runs[i].steps = steps;
+    }
+
+    std::cout << "threads,runs,seconds,runs_per_sec,speedup,efficiency" << std::endl;
+
+    double baseline = 0.0;
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::ostringstream csv;
+        auto begin = std::chrono::steady_clock::now();
+        runBatch(runs, threads, csv);
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        if (threads == 1) {
+            baseline = seconds;
+        }
+        double speedup = baseline / seconds;
+        std::cout << threads << ',' << numRuns << ',' << seconds << ',' << numRuns / seconds << ',' << speedup << ','
+                  << speedup / threads << std::endl;
+    }
+
+    return 0;
+}
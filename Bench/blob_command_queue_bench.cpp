@@ -0,0 +1,87 @@
+#include "../Source/BlobCommandQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Measures command throughput with N producers pushing into one queue while a
+// single consumer drains and applies batches, as the simulation does each step.
+// Producers retry on overflow, so every command is eventually delivered;
+// `retries` counts rejected push calls and `lost` must stay zero.
+int main(int argc, char* argv[]) {
+    unsigned int maxProducers = argc >= 2 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t perProducer = argc >= 3 ? std::atoi(argv[2]) : 1000000;
+    const std::size_t bulkSize = 16;
+
+    std::cout << "producers,mode,commands,seconds,mcmd_per_sec,retries,lost,batches,peak_batch" << std::endl;
+
+    for (unsigned int numProducers = 1; numProducers <= maxProducers; numProducers *= 2) {
+        for (bool bulk : {false, true}) {
+            BlobCommandQueue queue(8192);
+            std::atomic<bool> start{false};
+            std::atomic<unsigned int> finished{0};
+            std::atomic<std::uint64_t> retries{0};
+
+            std::vector<std::thread> producers;
+            for (unsigned int p = 0; p < numProducers; ++p) {
+                producers.emplace_back([&, p] {
+                    std::vector<BlobCommand> chunk(bulkSize, BlobCommand::impulse(p + 1, sf::Vector2f(1.0f, 0.0f)));
+                    while (!start.load(std::memory_order_acquire)) {}
+
+                    std::size_t sent = 0;
+                    std::uint64_t localRetries = 0;
+                    while (sent < perProducer) {
+                        // The last bulk push is trimmed so exactly perProducer commands go out
+                        std::size_t count = bulk ? std::min(bulkSize, perProducer - sent) : 1;
+                        bool accepted = bulk ? queue.pushBulk(std::span<const BlobCommand>(chunk.data(), count))
+                                             : queue.push(chunk[0]);
+                        if (accepted) {
+                            sent += count;
+                        } else {
+                            ++localRetries;
+                            std::this_thread::yield(); // Full; let the consumer catch up
+                        }
+                    }
+                    retries.fetch_add(localRetries, std::memory_order_relaxed);
+                    finished.fetch_add(1, std::memory_order_release);
+                });
+            }
+
+            std::vector<Blob> blobs;
+            for (unsigned int p = 0; p < numProducers; ++p) {
+                blobs.emplace_back(100.0f, 100.0f, 20.0f, sf::Color::Red);
+                blobs.back().setId(p + 1);
+            }
+
+            std::vector<BlobCommand> batch;
+            BlobCommandScratch scratch;
+            auto begin = std::chrono::steady_clock::now();
+            start.store(true, std::memory_order_release);
+
+            while (finished.load(std::memory_order_acquire) < numProducers || queue.getStats().drained < queue.getStats().pushed) {
+                batch.clear();
+                if (queue.drain(batch, queue.capacity()) > 0) {
+                    applyBlobCommands(batch, blobs, 1.0f / 60.0f, scratch);
+                }
+            }
+
+            auto end = std::chrono::steady_clock::now();
+            for (auto& producer : producers) {
+                producer.join();
+            }
+
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            auto stats = queue.getStats();
+            std::uint64_t expected = static_cast<std::uint64_t>(numProducers) * perProducer;
+            std::cout << numProducers << ',' << (bulk ? "bulk" : "single") << ',' << stats.drained << ','
+                      << seconds << ',' << stats.drained / seconds / 1e6 << ',' << retries.load() << ','
+                      << expected - stats.drained << ',' << stats.batches << ',' << stats.peakBatch << std::endl;
+        }
+    }
+
+    return 0;
+}
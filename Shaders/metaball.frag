@@ -1,10 +1,9 @@
-#version 330 core
+#version 330 compatibility
 
 in vec2 fragCoord;
 out vec4 FragColor;
 
-uniform vec2 resolution;
-uniform int blobCount;
+uniform int blobCount; // At most 100, the size of the arrays below
 uniform vec2 blobPositions[100];
 uniform float blobRadii[100];
 uniform vec4 blobColors[100];
@@ -30,7 +29,7 @@ float metaball(vec2 pos, vec2 center, float radius) {
 }
 
 void main() {
-    vec2 uv = fragCoord * resolution;
+    vec2 uv = fragCoord;
     
     float totalInfluence = 0.0;
     vec4 totalColor = vec4(0.0);
@@ -1,10 +1,9 @@
-#version 330 core
-
-layout(location = 0) in vec2 position;
+#version 330 compatibility
 
+// Pixel coordinates, y down, the same frame as blob positions and MetaballField tiles
 out vec2 fragCoord;
 
 void main() {
-    fragCoord = position;
-    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+    fragCoord = gl_Vertex.xy;
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
 }
\ No newline at end of file
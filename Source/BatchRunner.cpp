@@ -0,0 +1,394 @@
+#include "BatchRunner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+// What a value must satisfy before it reaches the simulation
+enum class Constraint { Finite, Positive, NonNegative, Unit, PositiveInteger, NonNegativeInteger };
+
+// Integer values are cast to their field's type, so they need an upper bound too
+constexpr double MAX_INT = std::numeric_limits<int>::max();
+constexpr double MAX_UINT32 = std::numeric_limits<std::uint32_t>::max();
+constexpr double MAX_EXTENT = 16384.0; // Largest window or render texture side we support
+
+// Ranges are expanded eagerly, so a tiny step over a wide range must not
+// turn into a huge allocation
+constexpr std::size_t MAX_AXIS_VALUES = 100000;
+constexpr std::size_t MAX_RUNS = 1000000;
+
+struct ParamField {
+    const char* name;
+    Constraint constraint;
+    double max;
+    double (*get)(const SimulationParams&);
+    void (*set)(SimulationParams&, double);
+};
+
+// Every sweepable SimulationParams field, in CSV column order
+const ParamField paramFields[] = {
+    {"width", Constraint::PositiveInteger, MAX_EXTENT,
+              [](const SimulationParams& p) -> double { return p.width; },
+              [](SimulationParams& p, double v) { p.width = static_cast<unsigned int>(v); }},
+    {"height", Constraint::PositiveInteger, MAX_EXTENT,
+               [](const SimulationParams& p) -> double { return p.height; },
+               [](SimulationParams& p, double v) { p.height = static_cast<unsigned int>(v); }},
+    {"numBlobs", Constraint::NonNegativeInteger, MAX_INT,
+                 [](const SimulationParams& p) -> double { return p.numBlobs; },
+                 [](SimulationParams& p, double v) { p.numBlobs = static_cast<int>(v); }},
+    {"gravityStrength", Constraint::Finite, HUGE_VAL,
+                        [](const SimulationParams& p) -> double { return p.gravityStrength; },
+                        [](SimulationParams& p, double v) { p.gravityStrength = static_cast<float>(v); }},
+    {"minDistance", Constraint::Positive, HUGE_VAL,
+                    [](const SimulationParams& p) -> double { return p.minDistance; },
+                    [](SimulationParams& p, double v) { p.minDistance = static_cast<float>(v); }},
+    {"damping", Constraint::Unit, 1.0,
+                [](const SimulationParams& p) -> double { return p.damping; },
+                [](SimulationParams& p, double v) { p.damping = static_cast<float>(v); }},
+    {"collisionWindow", Constraint::NonNegative, HUGE_VAL,
+                        [](const SimulationParams& p) -> double { return p.collisionWindow; },
+                        [](SimulationParams& p, double v) { p.collisionWindow = static_cast<float>(v); }},
+    // Zero radius means zero mass, and applyForce divides by mass
+    {"minRadius", Constraint::Positive, HUGE_VAL,
+                  [](const SimulationParams& p) -> double { return p.minRadius; },
+                  [](SimulationParams& p, double v) { p.minRadius = static_cast<float>(v); }},
+    {"maxRadius", Constraint::Positive, HUGE_VAL,
+                  [](const SimulationParams& p) -> double { return p.maxRadius; },
+                  [](SimulationParams& p, double v) { p.maxRadius = static_cast<float>(v); }},
+};
+
+const ParamField* findField(const std::string& name) {
+    for (const auto& field : paramFields) {
+        if (name == field.name) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+std::string trim(const std::string& s) {
+    auto begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    auto end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+double parseNumber(const std::string& text, int lineNumber) {
+    std::string value = trim(text);
+    std::size_t consumed = 0;
+    double result = 0.0;
+    try {
+        result = std::stod(value, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    if (value.empty() || consumed != value.size()) {
+        throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": bad number '" + value + "'");
+    }
+    return result;
+}
+
+void checkValue(const std::string& key, double value, Constraint constraint, double max, int lineNumber) {
+    const char* requirement = nullptr;
+    bool isInteger = std::floor(value) == value;
+
+    switch (constraint) {
+    case Constraint::Finite:
+        break;
+    case Constraint::Positive:
+        if (!(value > 0.0)) requirement = "must be greater than 0";
+        break;
+    case Constraint::NonNegative:
+        if (!(value >= 0.0)) requirement = "must not be negative";
+        break;
+    case Constraint::Unit:
+        if (!(value >= 0.0 && value <= 1.0)) requirement = "must be between 0 and 1";
+        break;
+    case Constraint::PositiveInteger:
+        if (!(value >= 1.0 && isInteger)) requirement = "must be a whole number of at least 1";
+        break;
+    case Constraint::NonNegativeInteger:
+        if (!(value >= 0.0 && isInteger)) requirement = "must be a whole number of at least 0";
+        break;
+    }
+
+    if (!std::isfinite(value)) {
+        requirement = "must be finite";
+    }
+
+    if (requirement) {
+        std::ostringstream message;
+        message << "Sweep spec line " << lineNumber << ": " << key << " = " << value << ' ' << requirement;
+        throw std::runtime_error(message.str());
+    }
+
+    if (value > max) {
+        std::ostringstream message;
+        message << std::fixed;
+        message.precision(0);
+        message << "Sweep spec line " << lineNumber << ": " << key << " = " << value << " must be at most " << max;
+        throw std::runtime_error(message.str());
+    }
+}
+
+std::vector<double> parseValues(const std::string& text, int lineNumber) {
+    std::vector<double> values;
+
+    if (text.find(':') != std::string::npos) {
+        std::vector<double> parts;
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ':')) {
+            parts.push_back(parseNumber(part, lineNumber));
+        }
+        if (parts.size() != 3 || parts[2] <= 0.0 || parts[1] < parts[0]) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": range must be start:stop:step");
+        }
+
+        // Count steps up front so float error can't drop the inclusive end point
+        double steps = std::floor((parts[1] - parts[0]) / parts[2] + 1e-9);
+        if (!(steps < MAX_AXIS_VALUES)) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": range has more than " +
+                                     std::to_string(MAX_AXIS_VALUES) + " values");
+        }
+        auto count = static_cast<std::size_t>(steps) + 1;
+        for (std::size_t i = 0; i < count; ++i) {
+            values.push_back(parts[0] + i * parts[2]);
+        }
+    } else {
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            values.push_back(parseNumber(part, lineNumber));
+        }
+        if (values.size() > MAX_AXIS_VALUES) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": list has more than " +
+                                     std::to_string(MAX_AXIS_VALUES) + " values");
+        }
+    }
+
+    return values;
+}
+
+} // namespace
+
+SweepSpec SweepSpec::parse(std::istream& in) {
+    SweepSpec spec;
+    std::string line;
+    int lineNumber = 0;
+    std::map<std::string, int> seenKeys; // Key -> line it was first set on
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        auto equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": expected key = value");
+        }
+
+        std::string key = trim(line.substr(0, equals));
+        auto [previous, isNew] = seenKeys.emplace(key, lineNumber);
+        if (!isNew) {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": '" + key +
+                                     "' already set on line " + std::to_string(previous->second));
+        }
+
+        std::vector<double> values = parseValues(line.substr(equals + 1), lineNumber);
+
+        if (key == "steps" || key == "dt" || key == "seeds" || key == "seed") {
+            if (values.size() != 1) {
+                throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": '" + key + "' takes one value");
+            }
+            if (key == "steps") {
+                checkValue(key, values[0], Constraint::PositiveInteger, MAX_INT, lineNumber);
+                spec.steps = static_cast<int>(values[0]);
+            } else if (key == "dt") {
+                checkValue(key, values[0], Constraint::Positive, HUGE_VAL, lineNumber);
+                spec.dt = static_cast<float>(values[0]);
+            } else if (key == "seeds") {
+                checkValue(key, values[0], Constraint::PositiveInteger, MAX_INT, lineNumber);
+                spec.seedsPerPoint = static_cast<int>(values[0]);
+            } else {
+                checkValue(key, values[0], Constraint::NonNegativeInteger, MAX_UINT32, lineNumber);
+                spec.baseSeed = static_cast<std::uint32_t>(values[0]);
+            }
+        } else if (const ParamField* field = findField(key)) {
+            for (double value : values) {
+                checkValue(key, value, field->constraint, field->max, lineNumber);
+            }
+            spec.axes.emplace_back(key, std::move(values));
+        } else {
+            throw std::runtime_error("Sweep spec line " + std::to_string(lineNumber) + ": unknown key '" + key + "'");
+        }
+    }
+
+    return spec;
+}
+
+std::vector<BatchRun> SweepSpec::expand() const {
+    std::vector<BatchRun> runs;
+    std::vector<std::size_t> counter(axes.size(), 0);
+
+    // Checked before allocating anything; each factor is at least 1
+    double total = seedsPerPoint;
+    for (const auto& axis : axes) {
+        total *= axis.second.size();
+    }
+    if (total > MAX_RUNS) {
+        throw std::runtime_error("Sweep spec expands to more than " + std::to_string(MAX_RUNS) + " runs");
+    }
+    runs.reserve(static_cast<std::size_t>(total));
+
+    // Odometer over the axes; the last axis varies fastest
+    for (;;) {
+        SimulationParams params;
+        for (std::size_t a = 0; a < axes.size(); ++a) {
+            findField(axes[a].first)->set(params, axes[a].second[counter[a]]);
+        }
+
+        // Per-key checks happen in parse(); this pair only fails in combination
+        if (params.minRadius > params.maxRadius) {
+            std::ostringstream message;
+            message << "Sweep spec: minRadius " << params.minRadius << " exceeds maxRadius " << params.maxRadius
+                    << " for run " << runs.size();
+            throw std::runtime_error(message.str());
+        }
+
+        for (int s = 0; s < seedsPerPoint; ++s) {
+            BatchRun run;
+            run.index = runs.size();
+            run.params = params;
+            run.params.seed = baseSeed + s;
+            run.steps = steps;
+            run.dt = dt;
+            runs.push_back(run);
+        }
+
+        std::size_t a = axes.size();
+        while (a > 0 && ++counter[a - 1] == axes[a - 1].second.size()) {
+            counter[a - 1] = 0;
+            --a;
+        }
+        if (a == 0) {
+            break;
+        }
+    }
+
+    return runs;
+}
+
+BatchResult runSimulation(BlobWorld& world, const BatchRun& run) {
+    world.reset(run.params, run.dt);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < run.steps; ++i) {
+        world.step(run.dt);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto metrics = world.measure(run.dt);
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    BatchResult result;
+    result.index = run.index;
+    result.params = run.params;
+    result.kineticEnergy = metrics.kineticEnergy;
+    result.clusterCount = metrics.clusterCount;
+    result.overlap = metrics.overlap;
+    result.stepsPerSecond = seconds > 0.0 ? run.steps / seconds : 0.0;
+    return result;
+}
+
+void runBatch(const std::vector<BatchRun>& runs, unsigned int threads, std::ostream& csv) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, std::max<std::size_t>(runs.size(), 1)));
+
+    std::atomic<std::size_t> nextRun{0};
+    std::mutex csvMutex;
+    std::exception_ptr failure; // First exception from any worker, guarded by csvMutex
+
+    writeCsvHeader(csv);
+
+    // Runs share nothing but the work counter and the output stream, so each
+    // worker only synchronizes once per finished run
+    auto worker = [&] {
+        try {
+            // Constructed on the worker thread so its storage is local to that core
+            BlobWorld world{SimulationParams{}};
+            std::ostringstream row;
+
+            for (std::size_t i = nextRun.fetch_add(1); i < runs.size(); i = nextRun.fetch_add(1)) {
+                BatchResult result = runSimulation(world, runs[i]);
+
+                row.str("");
+                writeCsvRow(row, result);
+
+                std::lock_guard<std::mutex> lock(csvMutex);
+                csv << row.str() << std::flush;
+            }
+        } catch (...) {
+            // An escaping exception would terminate the process; stop handing
+            // out runs and let runBatch rethrow once every thread has joined
+            nextRun.store(runs.size());
+            std::lock_guard<std::mutex> lock(csvMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    try {
+        for (unsigned int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+    } catch (const std::system_error&) {
+        // Out of threads; carry on with the ones that started
+    }
+    worker();
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void writeCsvHeader(std::ostream& csv) {
+    csv << "run,seed";
+    for (const auto& field : paramFields) {
+        csv << ',' << field.name;
+    }
+    csv << ",kinetic_energy,clusters,overlap,steps_per_sec\n";
+}
+
+void writeCsvRow(std::ostream& csv, const BatchResult& result) {
+    csv << result.index << ',' << result.params.seed;
+    for (const auto& field : paramFields) {
+        csv << ',' << field.get(result.params);
+    }
+    csv << ',' << result.kineticEnergy << ',' << result.clusterCount << ',' << result.overlap << ','
+        << result.stepsPerSecond << '\n';
+}
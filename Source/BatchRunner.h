@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BlobWorld.h"
+#include "SimulationParams.h"
+
+// One headless simulation in a sweep
+struct BatchRun {
+    std::size_t index = 0;
+    SimulationParams params;
+    int steps = 3600;
+    float dt = 1.0f / 60.0f;
+};
+
+struct BatchResult {
+    std::size_t index = 0;
+    SimulationParams params;
+    double kineticEnergy = 0.0;
+    int clusterCount = 0;
+    double overlap = 0.0;
+    double stepsPerSecond = 0.0;
+};
+
+// Parameter sweep description. Text format, one `key = value` per line, `#` comments:
+//   steps = 3600                  Steps per run
+//   dt = 0.0166667                Fixed time step
+//   seeds = 4                     Runs per parameter combination (seeds seed, seed+1, ...)
+//   seed = 1                      First seed
+//   gravityStrength = 1000:4000:500   Inclusive start:stop:step range
+//   damping = 0.99, 0.995, 0.999      Explicit list
+// Any SimulationParams field except seed may be swept; runs are the cartesian
+// product of all axes in the order they appear. Values are range-checked per
+// key in parse() (e.g. positive radii, whole-number counts, damping in [0, 1]),
+// and each key may appear once; expand() throws if a combination has
+// minRadius > maxRadius or the sweep has more than a million runs.
+struct SweepSpec {
+    std::vector<std::pair<std::string, std::vector<double>>> axes;
+    int steps = 3600;
+    float dt = 1.0f / 60.0f;
+    int seedsPerPoint = 1;
+    std::uint32_t baseSeed = 1;
+
+    static SweepSpec parse(std::istream& in); // Throws std::runtime_error on malformed input
+    std::vector<BatchRun> expand() const;
+};
+
+// Resets `world` to the run's parameters and steps it; reusing one world per
+// worker keeps its blob storage allocated across runs
+BatchResult runSimulation(BlobWorld& world, const BatchRun& run);
+
+// Runs every simulation on `threads` workers (0 = one per core) and streams a
+// CSV row to `csv` as each run finishes, so rows are not in index order.
+// If a run throws, the remaining runs are skipped and the first exception is
+// rethrown after all workers have joined.
+void runBatch(const std::vector<BatchRun>& runs, unsigned int threads, std::ostream& csv);
+
+void writeCsvHeader(std::ostream& csv);
+void writeCsvRow(std::ostream& csv, const BatchResult& result);
@@ -10,8 +10,8 @@ Blob::Blob(float x, float y, float radius, sf::Color color)
     updateMass();
 }
 
-void Blob::update(float dt, const sf::Vector2u& windowSize) {
-    verletIntegration(dt);
+void Blob::update(float dt, const sf::Vector2u& windowSize, float damping) {
+    verletIntegration(dt, damping);
     wrapBounds(windowSize);
     
     distortionFactor *= 0.95f;
@@ -21,9 +21,14 @@ void Blob::applyForce(const sf::Vector2f& force) {
     acceleration += force / mass;
 }
 
-void Blob::verletIntegration(float dt) {
+void Blob::applyImpulse(const sf::Vector2f& impulse, float dt) {
+    // Verlet keeps velocity implicitly, so shift the previous position instead
+    previousPosition -= impulse / mass * dt;
+}
+
+void Blob::verletIntegration(float dt, float damping) {
     sf::Vector2f velocity = position - previousPosition;
-    velocity *= 0.995f; // Less damping for more sustained movement
+    velocity *= damping; // Close to 1 for sustained movement, see SimulationParams
     previousPosition = position;
     position += velocity + acceleration * dt * dt;
     acceleration = sf::Vector2f(0.0f, 0.0f);
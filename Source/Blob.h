@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include <cmath>
+#include <cstdint>
 
 class Blob {
 public:
@@ -10,22 +11,26 @@ public:
     
     Blob(float x, float y, float radius, sf::Color color);
     
-    void update(float dt, const sf::Vector2u& windowSize);
+    void update(float dt, const sf::Vector2u& windowSize, float damping);
     void applyForce(const sf::Vector2f& force);
+    void applyImpulse(const sf::Vector2f& impulse, float dt);
     void handleCollision(Blob& other);
     
     float getX() const { return position.x; }
     float getY() const { return position.y; }
     sf::Vector2f getPosition() const { return position; }
+    sf::Vector2f getPreviousPosition() const { return previousPosition; }
     float getRadius() const { return radius; }
     float getMass() const { return mass; }
     sf::Color getColor() const { return color; }
     float getDensity() const { return DENSITY; }
+    std::uint32_t getId() const { return id; }
     
     void setPosition(const sf::Vector2f& pos) { position = pos; }
     void setPreviousPosition(const sf::Vector2f& pos) { previousPosition = pos; }
     void setRadius(float r);
     void setColor(const sf::Color& c) { color = c; }
+    void setId(std::uint32_t value) { id = value; }
     
     float getDistortionFactor() const { return distortionFactor; }
     sf::Vector2f getDistortionDirection() const { return distortionDirection; }
@@ -40,11 +45,12 @@ private:
     float radius;
     float mass;
     sf::Color color;
+    std::uint32_t id = 0; // 0 = not addressable by commands
     
     float distortionFactor = 0.0f;
     sf::Vector2f distortionDirection;
     
-    void verletIntegration(float dt);
+    void verletIntegration(float dt, float damping);
     void wrapBounds(const sf::Vector2u& windowSize);
     float calculateDistance(const Blob& other) const;
     void updateMass();
@@ -0,0 +1,254 @@
+#include "BlobCommandQueue.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <thread>
+
+BlobCommand BlobCommand::spawn(std::uint32_t id, const sf::Vector2f& position, const sf::Vector2f& velocity,
+                               float radius, const sf::Color& color) {
+    BlobCommand command;
+    command.type = Type::Spawn;
+    command.blobId = id;
+    command.position = position;
+    command.vector = velocity;
+    command.radius = radius;
+    command.color = color;
+    return command;
+}
+
+BlobCommand BlobCommand::impulse(std::uint32_t id, const sf::Vector2f& impulse) {
+    BlobCommand command;
+    command.type = Type::Impulse;
+    command.blobId = id;
+    command.vector = impulse;
+    return command;
+}
+
+BlobCommand BlobCommand::remove(std::uint32_t id) {
+    BlobCommand command;
+    command.type = Type::Remove;
+    command.blobId = id;
+    return command;
+}
+
+BlobCommandQueue::BlobCommandQueue(std::size_t capacity)
+    : slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2))))
+    , mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+
+    // Each slot's sequence equals the position that may write it next
+    for (std::size_t i = 0; i <= mask; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool BlobCommandQueue::claim(std::size_t count, std::size_t& start) {
+    if (count > capacity()) {
+        return false;
+    }
+
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        // The consumer frees slots in order, so if the last slot of the range
+        // is free for this lap then every slot before it is as well
+        std::size_t last = pos + count - 1;
+        std::size_t seq = slots[last & mask].sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(last);
+
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                start = pos;
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // Full
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool BlobCommandQueue::push(const BlobCommand& command) {
+    std::size_t pos;
+    if (!claim(1, pos)) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Slot& slot = slots[pos & mask];
+    slot.command = command;
+    slot.sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool BlobCommandQueue::pushBulk(std::span<const BlobCommand> commands) {
+    if (commands.empty()) {
+        return true;
+    }
+
+    std::size_t start;
+    if (!claim(commands.size(), start)) {
+        droppedCount.fetch_add(commands.size(), std::memory_order_relaxed);
+        return false;
+    }
+
+    // One CAS for the whole range, then publish slot by slot
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        Slot& slot = slots[(start + i) & mask];
+        slot.command = commands[i];
+        slot.sequence.store(start + i + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+std::size_t BlobCommandQueue::drain(std::vector<BlobCommand>& out, std::size_t maxCount) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    std::size_t count = 0;
+
+    while (count < maxCount) {
+        Slot& slot = slots[pos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break; // Empty, or the next producer hasn't published yet
+        }
+
+        out.push_back(slot.command);
+        slot.sequence.store(pos + mask + 1, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+
+    if (count > 0) {
+        dequeuePos.store(pos, std::memory_order_release);
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+        if (count > peakBatch.load(std::memory_order_relaxed)) {
+            peakBatch.store(count, std::memory_order_relaxed);
+        }
+    }
+
+    return count;
+}
+
+std::size_t BlobCommandQueue::discard() {
+    // Everything claimed before this point; later pushes are left for drain()
+    std::size_t end = enqueuePos.load(std::memory_order_relaxed);
+    std::size_t begin = dequeuePos.load(std::memory_order_relaxed);
+
+    for (std::size_t pos = begin; pos != end; ++pos) {
+        Slot& slot = slots[pos & mask];
+        while (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            std::this_thread::yield(); // Claimed, but the producer is still writing it
+        }
+        slot.sequence.store(pos + mask + 1, std::memory_order_release);
+    }
+
+    dequeuePos.store(end, std::memory_order_release);
+    discardedCount.fetch_add(end - begin, std::memory_order_relaxed);
+    return end - begin;
+}
+
+BlobCommandQueue::Stats BlobCommandQueue::getStats() const {
+    Stats stats;
+    stats.pushed = enqueuePos.load(std::memory_order_relaxed);
+    stats.dropped = droppedCount.load(std::memory_order_relaxed);
+    stats.discarded = discardedCount.load(std::memory_order_relaxed);
+    stats.drained = dequeuePos.load(std::memory_order_relaxed) - stats.discarded;
+    stats.rejected = rejectedCount.load(std::memory_order_relaxed);
+    stats.batches = batchCount.load(std::memory_order_relaxed);
+    stats.peakBatch = peakBatch.load(std::memory_order_relaxed);
+    return stats;
+}
+
+namespace {
+
+bool isFinite(const sf::Vector2f& v) {
+    return std::isfinite(v.x) && std::isfinite(v.y);
+}
+
+bool isValid(const BlobCommand& command) {
+    switch (command.type) {
+    case BlobCommand::Type::Spawn:
+        return isFinite(command.position) && isFinite(command.vector) && std::isfinite(command.radius) &&
+               command.radius > 0.0f;
+    case BlobCommand::Type::Impulse:
+        return isFinite(command.vector);
+    case BlobCommand::Type::Remove:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+BlobCommandResult applyBlobCommands(std::span<const BlobCommand> commands, std::vector<Blob>& blobs, float frameTime,
+                                    BlobCommandScratch& scratch) {
+    BlobCommandResult result;
+    bool needsLookup = false;
+
+    auto spawnCount = std::count_if(commands.begin(), commands.end(), [](const BlobCommand& c) {
+        return c.type == BlobCommand::Type::Spawn;
+    });
+    blobs.reserve(blobs.size() + spawnCount);
+
+    for (const auto& command : commands) {
+        if (!isValid(command)) {
+            ++result.rejected;
+            continue;
+        }
+        if (command.type != BlobCommand::Type::Spawn) {
+            needsLookup = true;
+            continue;
+        }
+
+        blobs.emplace_back(command.position.x, command.position.y, command.radius, command.color);
+        blobs.back().setId(command.blobId);
+        // For Verlet integration, velocity is set through the previous position
+        blobs.back().setPreviousPosition(command.position - command.vector * frameTime);
+        ++result.applied;
+    }
+
+    // Spawn-only batches skip building the id lookup entirely
+    if (!needsLookup) {
+        return result;
+    }
+
+    // clear() keeps the buckets, so steady-state batches don't allocate
+    auto& indexById = scratch.indexById;
+    indexById.clear();
+    for (std::size_t i = 0; i < blobs.size(); ++i) {
+        if (blobs[i].getId() != 0) {
+            indexById[blobs[i].getId()] = i;
+        }
+    }
+
+    auto& removals = scratch.removals;
+    removals.clear();
+    for (const auto& command : commands) {
+        if (command.type == BlobCommand::Type::Spawn || !isValid(command)) {
+            continue;
+        }
+
+        auto it = indexById.find(command.blobId);
+        if (it == indexById.end()) {
+            continue;
+        }
+
+        if (command.type == BlobCommand::Type::Impulse) {
+            blobs[it->second].applyImpulse(command.vector, frameTime);
+            ++result.applied;
+        } else {
+            removals.push_back(command.blobId);
+            ++result.applied;
+        }
+    }
+
+    if (!removals.empty()) {
+        std::sort(removals.begin(), removals.end());
+        removals.erase(std::unique(removals.begin(), removals.end()), removals.end());
+
+        std::erase_if(blobs, [&removals](const Blob& blob) {
+            return std::binary_search(removals.begin(), removals.end(), blob.getId());
+        });
+    }
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "Blob.h"
+
+struct BlobCommand {
+    enum class Type : std::uint8_t { None, Spawn, Impulse, Remove };
+
+    Type type = Type::None; // Default-constructed commands are rejected when applied
+    std::uint32_t blobId = 0;
+    sf::Vector2f position;  // Spawn only
+    sf::Vector2f vector;    // Spawn: initial velocity (px/s), Impulse: impulse
+    float radius = 0.0f;    // Spawn only
+    sf::Color color;        // Spawn only
+
+    static BlobCommand spawn(std::uint32_t id, const sf::Vector2f& position, const sf::Vector2f& velocity,
+                             float radius, const sf::Color& color);
+    static BlobCommand impulse(std::uint32_t id, const sf::Vector2f& impulse);
+    static BlobCommand remove(std::uint32_t id);
+};
+
+// Bounded lock-free multi-producer/single-consumer queue of blob commands.
+// Any thread may push; only the simulation thread may drain.
+class BlobCommandQueue {
+public:
+    struct Stats {
+        std::uint64_t pushed = 0;   // Commands accepted
+        std::uint64_t dropped = 0;  // Commands rejected because the queue was full
+        std::uint64_t drained = 0;  // Commands handed to the consumer
+        std::uint64_t discarded = 0; // Commands thrown away by discard()
+        std::uint64_t rejected = 0; // Drained commands the consumer reported as invalid
+        std::uint64_t batches = 0;  // Non-empty drain calls
+        std::size_t peakBatch = 0;  // Largest single drain
+    };
+
+    explicit BlobCommandQueue(std::size_t capacity = 4096); // Rounded up to a power of two
+
+    BlobCommandQueue(const BlobCommandQueue&) = delete;
+    BlobCommandQueue& operator=(const BlobCommandQueue&) = delete;
+
+    // Producer side
+    bool push(const BlobCommand& command);
+    bool pushBulk(std::span<const BlobCommand> commands); // All or nothing
+    // Unique id for a blob spawned through this queue; starts at 1, 0 means "no id"
+    std::uint32_t reserveBlobId() { return nextBlobId.fetch_add(1, std::memory_order_relaxed); }
+
+    // Consumer side
+    std::size_t drain(std::vector<BlobCommand>& out, std::size_t maxCount);
+    // Drops everything pushed before the call. Commands pushed meanwhile stay
+    // queued, so busy producers can't keep the consumer here.
+    std::size_t discard();
+    void recordRejected(std::size_t count) { rejectedCount.fetch_add(count, std::memory_order_relaxed); }
+
+    std::size_t capacity() const { return mask + 1; }
+    Stats getStats() const;
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        BlobCommand command;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePos{0};
+    alignas(CACHE_LINE) std::atomic<std::uint64_t> droppedCount{0};
+    alignas(CACHE_LINE) std::atomic<std::uint32_t> nextBlobId{1};
+
+    // Written by the consumer only; atomic so stats can be read from any thread
+    alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePos{0};
+    std::atomic<std::uint64_t> batchCount{0};
+    std::atomic<std::size_t> peakBatch{0};
+    std::atomic<std::uint64_t> discardedCount{0};
+    std::atomic<std::uint64_t> rejectedCount{0};
+
+    bool claim(std::size_t count, std::size_t& start);
+};
+
+// Buffers reused across applyBlobCommands calls so applying a batch doesn't allocate
+struct BlobCommandScratch {
+    std::unordered_map<std::uint32_t, std::size_t> indexById;
+    std::vector<std::uint32_t> removals;
+};
+
+struct BlobCommandResult {
+    std::size_t applied = 0;  // Every valid spawn, and each impulse or remove whose id exists, duplicates included
+    std::size_t rejected = 0; // Invalid commands, see applyBlobCommands
+};
+
+// Applies a drained batch to the blob list. Spawns are appended first (one
+// reserve for the whole batch), then impulses, then all removals in a single
+// erase pass, so an impulse may target a blob spawned in the same batch.
+// Commands come from other threads and are checked first: a spawn needs a
+// finite position and velocity and a finite radius above zero (zero radius
+// means zero mass, and applyForce divides by mass), an impulse a finite
+// vector, and Type::None is never valid. Invalid commands are skipped.
+// Spawn ids must come from reserveBlobId() so they are unique; with duplicate
+// ids a remove erases every match while an impulse reaches only one.
+BlobCommandResult applyBlobCommands(std::span<const BlobCommand> commands, std::vector<Blob>& blobs, float frameTime,
+                                    BlobCommandScratch& scratch);
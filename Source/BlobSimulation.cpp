@@ -4,21 +4,32 @@
 
 BlobSimulation::BlobSimulation(unsigned int width, unsigned int height)
     : window(sf::VideoMode(width, height), "Blob Simulation", sf::Style::Titlebar | sf::Style::Close)
-    , rng(std::random_device{}())
-    , posDist(0.0f, 1.0f)
-    , radiusDist(10.0f, 40.0f)
-    , colorDist(50, 255) {
+    , world(makeParams(width, height))
+    , metaballs(width, height) {
     
     window.setFramerateLimit(60);
 }
 
+SimulationParams BlobSimulation::makeParams(unsigned int width, unsigned int height) {
+    SimulationParams params;
+    params.width = width;
+    params.height = height;
+    params.seed = std::random_device{}();
+    return params;
+}
+
 void BlobSimulation::run() {
     if (!shaderManager.loadShaders()) {
         std::cerr << "Failed to load shaders!" << std::endl;
         return;
     }
     
-    initialize();
+    if (!metaballs.create()) {
+        std::cerr << "Failed to create metaball render target!" << std::endl;
+        return;
+    }
+    
+    world.initialize(targetFrameTime);
     
     while (window.isOpen()) {
         handleEvents();
@@ -26,48 +37,11 @@ void BlobSimulation::run() {
         float frameTime = clock.restart().asSeconds();
         frameTime = std::min(frameTime, 0.1f); // Cap frame time to prevent spiral of death
         
-        update(frameTime);
+        world.step(frameTime);
         render();
     }
 }
 
-void BlobSimulation::initialize() {
-    const int numBlobs = 30; // Start with fewer blobs
-    auto windowSize = window.getSize();
-    
-    
-    // Create a grid to better distribute initial positions
-    int gridSize = static_cast<int>(std::sqrt(numBlobs)) + 2; // More spacing
-    float cellWidth = windowSize.x / gridSize;
-    float cellHeight = windowSize.y / gridSize;
-    
-    for (int i = 0; i < numBlobs; ++i) {
-        // Place blobs in grid cells with some randomness
-        int gridX = i % gridSize;
-        int gridY = i / gridSize;
-        
-        float x = (gridX + 0.2f + posDist(rng) * 0.6f) * cellWidth;
-        float y = (gridY + 0.2f + posDist(rng) * 0.6f) * cellHeight;
-        float radius = radiusDist(rng);
-        sf::Color color = generateRandomColor();
-        
-        blobs.emplace_back(x, y, radius, color);
-        
-        // Set initial velocity by manipulating previous position
-        float angle = posDist(rng) * 2 * M_PI;
-        float speed = 30.0f + posDist(rng) * 70.0f; // Moderate speeds for visible movement
-        sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
-        
-        // For Verlet integration, we set velocity by adjusting previous position
-        blobs.back().setPosition(sf::Vector2f(x, y));
-        // This creates the initial velocity
-        sf::Vector2f prevPos = sf::Vector2f(x, y) - velocity * 0.016f; // Assume 60Hz
-        blobs.back().setPosition(sf::Vector2f(x, y)); // Reset current position
-        blobs.back().setPreviousPosition(prevPos);
-    }
-    
-}
-
 void BlobSimulation::handleEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
@@ -75,141 +49,15 @@ void BlobSimulation::handleEvents() {
             window.close();
         } else if (event.type == sf::Event::KeyPressed) {
             if (event.key.code == sf::Keyboard::Space) {
-                float x = posDist(rng) * window.getSize().x;
-                float y = posDist(rng) * window.getSize().y;
-                float radius = radiusDist(rng);
-                sf::Color color = generateRandomColor();
-                blobs.emplace_back(x, y, radius, color);
-                
-                // Set initial velocity
-                float angle = posDist(rng) * 2 * M_PI;
-                float speed = 30.0f + posDist(rng) * 70.0f; // Match the initialization speeds
-                sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
-                sf::Vector2f prevPos = sf::Vector2f(x, y) - velocity * 0.016f;
-                blobs.back().setPreviousPosition(prevPos);
+                world.spawnRandomBlob();
             } else if (event.key.code == sf::Keyboard::R) {
-                blobs.clear();
-                initialize();
-            }
-        }
-    }
-}
-
-void BlobSimulation::update(float dt) {
-    static int frameCount = 0;
-    
-    applyForces();
-    
-    for (auto& blob : blobs) {
-        blob.update(dt, window.getSize());
-    }
-    
-    
-    auto windowSize = window.getSize();
-    
-    for (size_t i = 0; i < blobs.size(); ++i) {
-        for (size_t j = i + 1; j < blobs.size(); ++j) {
-            // Check if blobs are close considering wrap-around
-            sf::Vector2f diff = blobs[j].getPosition() - blobs[i].getPosition();
-            
-            // Only handle collision if they're actually close (considering wrap-around)
-            bool closeX = std::abs(diff.x) < 150.0f || std::abs(diff.x) > windowSize.x - 150.0f;
-            bool closeY = std::abs(diff.y) < 150.0f || std::abs(diff.y) > windowSize.y - 150.0f;
-            
-            if (closeX && closeY) {
-                blobs[i].handleCollision(blobs[j]);
-            }
-        }
-    }
-    
-    // Don't merge blobs - let the metaball shader handle visual morphing
-    // checkMerging();
-}
-
-void BlobSimulation::applyForces() {
-    const float gravityStrength = 2000.0f; // Strong gravity for clear attraction
-    const float minDistance = 20.0f; // Minimum distance to prevent extreme forces
-    auto windowSize = window.getSize();
-    
-    for (size_t i = 0; i < blobs.size(); ++i) {
-        for (size_t j = i + 1; j < blobs.size(); ++j) {
-            sf::Vector2f diff = blobs[j].getPosition() - blobs[i].getPosition();
-            
-            // Check for wrap-around distances
-            if (std::abs(diff.x) > windowSize.x / 2) {
-                diff.x = diff.x > 0 ? diff.x - windowSize.x : diff.x + windowSize.x;
-            }
-            if (std::abs(diff.y) > windowSize.y / 2) {
-                diff.y = diff.y > 0 ? diff.y - windowSize.y : diff.y + windowSize.y;
-            }
-            
-            float distSq = diff.x * diff.x + diff.y * diff.y;
-            
-            if (distSq < minDistance * minDistance) {
-                distSq = minDistance * minDistance;
-            }
-            
-            float dist = std::sqrt(distSq);
-            sf::Vector2f direction = diff / dist;
-            
-            float forceMagnitude = gravityStrength * blobs[i].getMass() * blobs[j].getMass() / distSq;
-            
-            // Add extra attraction when very close for sticky morphing
-            if (dist < (blobs[i].getRadius() + blobs[j].getRadius()) * 1.5f) {
-                forceMagnitude *= 2.0f; // Double attraction when close
-            }
-            
-            forceMagnitude = std::min(forceMagnitude, 2000.0f); // Higher force cap for more movement
-            
-            sf::Vector2f force = direction * forceMagnitude;
-            blobs[i].applyForce(force);
-            blobs[j].applyForce(-force);
-        }
-    }
-}
-
-void BlobSimulation::checkMerging() {
-    std::vector<Blob> newBlobs;
-    std::vector<bool> merged(blobs.size(), false);
-    auto windowSize = window.getSize();
-    
-    for (size_t i = 0; i < blobs.size(); ++i) {
-        if (merged[i]) continue;
-        
-        bool foundMerge = false;
-        for (size_t j = i + 1; j < blobs.size(); ++j) {
-            if (merged[j]) continue;
-            
-            // Calculate wrap-around distance
-            sf::Vector2f diff = blobs[j].getPosition() - blobs[i].getPosition();
-            
-            // Check for wrap-around distances
-            if (std::abs(diff.x) > windowSize.x / 2) {
-                diff.x = diff.x > 0 ? diff.x - windowSize.x : diff.x + windowSize.x;
-            }
-            if (std::abs(diff.y) > windowSize.y / 2) {
-                diff.y = diff.y > 0 ? diff.y - windowSize.y : diff.y + windowSize.y;
-            }
-            
-            float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-            float sumRadii = blobs[i].getRadius() + blobs[j].getRadius();
-            float mergeThreshold = sumRadii; // Merge when overlapping at all
-            
-            if (distance < mergeThreshold) {
-                newBlobs.push_back(Blob::merge(blobs[i], blobs[j]));
-                merged[i] = true;
-                merged[j] = true;
-                foundMerge = true;
-                break;
+                SimulationParams params = world.getParams();
+                params.seed = std::random_device{}();
+                world.reset(params, targetFrameTime);
+                metaballs.invalidate();
             }
         }
-        
-        if (!foundMerge) {
-            newBlobs.push_back(blobs[i]);
-        }
     }
-    
-    blobs = std::move(newBlobs);
 }
 
 void BlobSimulation::render() {
@@ -269,52 +117,21 @@ void BlobSimulation::renderMetaballs() {
     
     if (!shader) {
         // Fallback to regular rendering
-        for (const auto& blob : blobs) {
+        for (const auto& blob : world.getBlobs()) {
             renderBlob(blob);
         }
         return;
     }
     
-    // Create fullscreen quad
-    sf::VertexArray quad(sf::TriangleStrip, 4);
-    quad[0].position = sf::Vector2f(0, 0);
-    quad[0].texCoords = sf::Vector2f(0, 0);
-    quad[1].position = sf::Vector2f(window.getSize().x, 0);
-    quad[1].texCoords = sf::Vector2f(1, 0);
-    quad[2].position = sf::Vector2f(0, window.getSize().y);
-    quad[2].texCoords = sf::Vector2f(0, 1);
-    quad[3].position = sf::Vector2f(window.getSize().x, window.getSize().y);
-    quad[3].texCoords = sf::Vector2f(1, 1);
-    
-    // Set shader uniforms
-    shader->setUniform("resolution", sf::Vector2f(window.getSize()));
-    shader->setUniform("blobCount", static_cast<int>(blobs.size()));
-    
-    // Pass blob data to shader
-    for (size_t i = 0; i < blobs.size() && i < 100; ++i) {
-        std::string posName = "blobPositions[" + std::to_string(i) + "]";
-        std::string radiusName = "blobRadii[" + std::to_string(i) + "]";
-        std::string colorName = "blobColors[" + std::to_string(i) + "]";
-        
-        shader->setUniform(posName, blobs[i].getPosition());
-        shader->setUniform(radiusName, blobs[i].getRadius());
-        shader->setUniform(colorName, sf::Glsl::Vec4(blobs[i].getColor()));
-    }
+    metaballs.render(*shader, world.getBlobs());
     
     // Enable alpha blending for smooth edges
-    sf::RenderStates states;
-    states.shader = shader;
-    states.blendMode = sf::BlendAlpha;
+    sf::Sprite sprite(metaballs.getTexture());
+    window.draw(sprite, sf::BlendAlpha);
     
-    // Draw with shader and blending
-    window.draw(quad, states);
-}
-
-sf::Color BlobSimulation::generateRandomColor() {
-    return sf::Color(
-        colorDist(rng),
-        colorDist(rng),
-        colorDist(rng),
-        255
-    );
+    // Report the tile cache hit rate about once a second
+    if (++metaballFrameCount % 60 == 0) {
+        int hitRate = static_cast<int>(metaballs.getLastFrameStats().hitRate() * 100.0);
+        window.setTitle("Blob Simulation - tile cache hit rate " + std::to_string(hitRate) + "%");
+    }
 }
\ No newline at end of file
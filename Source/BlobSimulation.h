@@ -3,8 +3,9 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
-#include <random>
 #include "Blob.h"
+#include "BlobWorld.h"
+#include "MetaballRenderer.h"
 #include "ShaderManager.h"
 
 class BlobSimulation {
@@ -13,27 +14,25 @@ public:
     
     void run();
     
+    // Thread-safe entry point for injecting spawns, impulses and removals
+    BlobCommandQueue& getCommandQueue() { return world.getCommandQueue(); }
+    
 private:
     sf::RenderWindow window;
     ShaderManager shaderManager;
-    std::vector<Blob> blobs;
+    BlobWorld world;
     
-    std::mt19937 rng;
-    std::uniform_real_distribution<float> posDist;
-    std::uniform_real_distribution<float> radiusDist;
-    std::uniform_int_distribution<int> colorDist;
+    // Metaball output persists between frames; only dirty tiles are redrawn
+    MetaballRenderer metaballs;
+    int metaballFrameCount = 0;
     
     sf::Clock clock;
     const float targetFrameTime = 1.0f / 60.0f; // 60 Hz
     
-    void initialize();
     void handleEvents();
-    void update(float dt);
     void render();
     void renderBlob(const Blob& blob);
     void renderMetaballs();
-    void checkMerging();
-    void applyForces();
     
-    sf::Color generateRandomColor();
+    static SimulationParams makeParams(unsigned int width, unsigned int height);
 };
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "BlobWorld.h"
+#include <algorithm>
+#include <numeric>
+
+BlobWorld::BlobWorld(const SimulationParams& params)
+    : params(params)
+    , rng(params.seed)
+    , posDist(0.0f, 1.0f)
+    , radiusDist(params.minRadius, params.maxRadius)
+    , colorDist(50, 255) {
+}
+
+void BlobWorld::initialize(float dt) {
+    const int numBlobs = params.numBlobs;
+    auto windowSize = getSize();
+
+
+    // Create a grid to better distribute initial positions
+    int gridSize = static_cast<int>(std::sqrt(numBlobs)) + 2; // More spacing
+    float cellWidth = windowSize.x / gridSize;
+    float cellHeight = windowSize.y / gridSize;
+
+    for (int i = 0; i < numBlobs; ++i) {
+        // Place blobs in grid cells with some randomness
+        int gridX = i % gridSize;
+        int gridY = i / gridSize;
+
+        float x = (gridX + 0.2f + posDist(rng) * 0.6f) * cellWidth;
+        float y = (gridY + 0.2f + posDist(rng) * 0.6f) * cellHeight;
+        float radius = radiusDist(rng);
+        sf::Color color = generateRandomColor();
+
+        blobs.emplace_back(x, y, radius, color);
+        blobs.back().setId(commandQueue.reserveBlobId());
+
+        // Set initial velocity by manipulating previous position
+        float angle = posDist(rng) * 2 * M_PI;
+        float speed = 30.0f + posDist(rng) * 70.0f; // Moderate speeds for visible movement
+        sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
+
+        // For Verlet integration, we set velocity by adjusting previous position
+        blobs.back().setPosition(sf::Vector2f(x, y));
+        // This creates the initial velocity
+        sf::Vector2f prevPos = sf::Vector2f(x, y) - velocity * dt;
+        blobs.back().setPosition(sf::Vector2f(x, y)); // Reset current position
+        blobs.back().setPreviousPosition(prevPos);
+    }
+
+}
+
+void BlobWorld::reset(const SimulationParams& newParams, float dt) {
+    params = newParams;
+    rng.seed(params.seed);
+    posDist.reset();
+    colorDist.reset();
+    radiusDist.param(std::uniform_real_distribution<float>::param_type(params.minRadius, params.maxRadius));
+
+    // clear() keeps capacity, so repeated runs on one world don't reallocate
+    blobs.clear();
+    commandBatch.clear();
+
+    // Commands queued for the old scene must not land in the new one
+    commandQueue.discard();
+
+    initialize(dt);
+}
+
+void BlobWorld::spawnRandomBlob() {
+    float x = posDist(rng) * params.width;
+    float y = posDist(rng) * params.height;
+    float radius = radiusDist(rng);
+    sf::Color color = generateRandomColor();
+
+    // Set initial velocity
+    float angle = posDist(rng) * 2 * M_PI;
+    float speed = 30.0f + posDist(rng) * 70.0f; // Match the initialization speeds
+    sf::Vector2f velocity(std::cos(angle) * speed, std::sin(angle) * speed);
+
+    // Goes through the queue like external spawns, applied at the start of the next step
+    commandQueue.push(BlobCommand::spawn(commandQueue.reserveBlobId(), sf::Vector2f(x, y), velocity, radius, color));
+}
+
+void BlobWorld::step(float dt) {
+    applyPendingCommands(dt);
+    applyForces();
+
+    for (auto& blob : blobs) {
+        blob.update(dt, getSize(), params.damping);
+    }
+
+    handleCollisions();
+
+    // Don't merge blobs - let the metaball shader handle visual morphing
+    // checkMerging();
+}
+
+void BlobWorld::applyPendingCommands(float dt) {
+    // Bounded per step so a flood of producers can't stall a frame
+    commandBatch.clear();
+    if (commandQueue.drain(commandBatch, commandQueue.capacity()) > 0) {
+        auto result = applyBlobCommands(commandBatch, blobs, dt, commandScratch);
+        commandQueue.recordRejected(result.rejected);
+    }
+}
+
+sf::Vector2f BlobWorld::wrappedDelta(const Blob& from, const Blob& to) const {
+    sf::Vector2f diff = to.getPosition() - from.getPosition();
+
+    // Check for wrap-around distances
+    if (std::abs(diff.x) > params.width / 2) {
+        diff.x = diff.x > 0 ? diff.x - params.width : diff.x + params.width;
+    }
+    if (std::abs(diff.y) > params.height / 2) {
+        diff.y = diff.y > 0 ? diff.y - params.height : diff.y + params.height;
+    }
+
+    return diff;
+}
+
+void BlobWorld::handleCollisions() {
+    const float window = params.collisionWindow;
+    auto windowSize = getSize();
+
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        for (size_t j = i + 1; j < blobs.size(); ++j) {
+            // Check if blobs are close considering wrap-around
+            sf::Vector2f diff = blobs[j].getPosition() - blobs[i].getPosition();
+
+            // Only handle collision if they're actually close (considering wrap-around)
+            bool closeX = std::abs(diff.x) < window || std::abs(diff.x) > windowSize.x - window;
+            bool closeY = std::abs(diff.y) < window || std::abs(diff.y) > windowSize.y - window;
+
+            if (closeX && closeY) {
+                blobs[i].handleCollision(blobs[j]);
+            }
+        }
+    }
+}
+
+void BlobWorld::applyForces() {
+    const float gravityStrength = params.gravityStrength;
+    const float minDistance = params.minDistance;
+
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        for (size_t j = i + 1; j < blobs.size(); ++j) {
+            sf::Vector2f diff = wrappedDelta(blobs[i], blobs[j]);
+
+            float distSq = diff.x * diff.x + diff.y * diff.y;
+
+            if (distSq < minDistance * minDistance) {
+                distSq = minDistance * minDistance;
+            }
+
+            float dist = std::sqrt(distSq);
+            sf::Vector2f direction = diff / dist;
+
+            float forceMagnitude = gravityStrength * blobs[i].getMass() * blobs[j].getMass() / distSq;
+
+            // Add extra attraction when very close for sticky morphing
+            if (dist < (blobs[i].getRadius() + blobs[j].getRadius()) * 1.5f) {
+                forceMagnitude *= 2.0f; // Double attraction when close
+            }
+
+            forceMagnitude = std::min(forceMagnitude, 2000.0f); // Higher force cap for more movement
+
+            sf::Vector2f force = direction * forceMagnitude;
+            blobs[i].applyForce(force);
+            blobs[j].applyForce(-force);
+        }
+    }
+}
+
+void BlobWorld::checkMerging() {
+    std::vector<Blob> newBlobs;
+    std::vector<bool> merged(blobs.size(), false);
+
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        if (merged[i]) continue;
+
+        bool foundMerge = false;
+        for (size_t j = i + 1; j < blobs.size(); ++j) {
+            if (merged[j]) continue;
+
+            // Calculate wrap-around distance
+            sf::Vector2f diff = wrappedDelta(blobs[i], blobs[j]);
+
+            float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+            float sumRadii = blobs[i].getRadius() + blobs[j].getRadius();
+            float mergeThreshold = sumRadii; // Merge when overlapping at all
+
+            if (distance < mergeThreshold) {
+                newBlobs.push_back(Blob::merge(blobs[i], blobs[j]));
+                merged[i] = true;
+                merged[j] = true;
+                foundMerge = true;
+                break;
+            }
+        }
+
+        if (!foundMerge) {
+            newBlobs.push_back(blobs[i]);
+        }
+    }
+
+    blobs = std::move(newBlobs);
+}
+
+BlobWorld::Metrics BlobWorld::measure(float dt) const {
+    Metrics metrics;
+
+    for (const auto& blob : blobs) {
+        sf::Vector2f velocity = (blob.getPosition() - blob.getPreviousPosition()) / dt;
+        metrics.kineticEnergy += 0.5 * blob.getMass() * (velocity.x * velocity.x + velocity.y * velocity.y);
+    }
+
+    // Union-find over touching pairs gives the cluster count
+    std::vector<size_t> parent(blobs.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    int clusters = static_cast<int>(blobs.size());
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        for (size_t j = i + 1; j < blobs.size(); ++j) {
+            sf::Vector2f diff = wrappedDelta(blobs[i], blobs[j]);
+            float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+            float sumRadii = blobs[i].getRadius() + blobs[j].getRadius();
+
+            if (distance < sumRadii) {
+                metrics.overlap += sumRadii - distance;
+
+                size_t rootI = find(i);
+                size_t rootJ = find(j);
+                if (rootI != rootJ) {
+                    parent[rootJ] = rootI;
+                    --clusters;
+                }
+            }
+        }
+    }
+    metrics.clusterCount = clusters;
+
+    return metrics;
+}
+
+sf::Color BlobWorld::generateRandomColor() {
+    return sf::Color(
+        colorDist(rng),
+        colorDist(rng),
+        colorDist(rng),
+        255
+    );
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <random>
+#include "Blob.h"
+#include "BlobCommandQueue.h"
+#include "SimulationParams.h"
+
+// Headless blob physics: everything the simulation does except windowing and
+// rendering, so it can be stepped without a display (e.g. in batch sweeps).
+class BlobWorld {
+public:
+    struct Metrics {
+        double kineticEnergy = 0.0;
+        int clusterCount = 0;       // Groups of blobs connected by touching pairs
+        double overlap = 0.0;       // Summed penetration depth over all pairs, in pixels
+    };
+
+    explicit BlobWorld(const SimulationParams& params);
+
+    // dt is the step length the run will use; initial velocities are encoded
+    // in previous positions, so they must be set up with the same step
+    void initialize(float dt);
+    void reset(const SimulationParams& newParams, float dt); // Reuses storage, discards queued commands
+    void step(float dt);
+    void spawnRandomBlob();
+
+    Metrics measure(float dt) const;
+
+    const std::vector<Blob>& getBlobs() const { return blobs; }
+    const SimulationParams& getParams() const { return params; }
+    sf::Vector2u getSize() const { return sf::Vector2u(params.width, params.height); }
+    BlobCommandQueue& getCommandQueue() { return commandQueue; }
+
+private:
+    SimulationParams params;
+    std::vector<Blob> blobs;
+    BlobCommandQueue commandQueue;
+    std::vector<BlobCommand> commandBatch;
+    BlobCommandScratch commandScratch;
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> posDist;
+    std::uniform_real_distribution<float> radiusDist;
+    std::uniform_int_distribution<int> colorDist;
+
+    void applyPendingCommands(float dt);
+    void applyForces();
+    void handleCollisions();
+    void checkMerging();
+    sf::Vector2f wrappedDelta(const Blob& from, const Blob& to) const;
+
+    sf::Color generateRandomColor();
+};
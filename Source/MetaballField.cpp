@@ -0,0 +1,209 @@
+#include "MetaballField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float smoothstep(float edge0, float edge1, float x) {
+    float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Mirrors metaball() in Shaders/metaball.frag
+float influence(float x, float y, const sf::Vector2f& center, float radius) {
+    float dx = x - center.x;
+    float dy = y - center.y;
+    float normalizedDist = std::sqrt(dx * dx + dy * dy) / radius;
+
+    float value = 0.0f;
+    if (normalizedDist < 1.0f) {
+        // Strong core influence
+        value = (1.0f - normalizedDist) * (1.0f - normalizedDist);
+    } else if (normalizedDist < MetaballField::SUPPORT) {
+        // Extended smooth falloff
+        float t = (normalizedDist - 1.0f) / 2.0f;
+        value = 0.5f * (1.0f - t) * (1.0f - t) * (1.0f - t);
+    }
+
+    return value * radius * radius / 20.0f;
+}
+
+sf::Uint8 toByte(float value) {
+    return static_cast<sf::Uint8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+MetaballField::MetaballField(unsigned int width, unsigned int height, float epsilon)
+    : width(width)
+    , height(height)
+    , tilesX((width + TILE_SIZE - 1) / TILE_SIZE)
+    , tilesY((height + TILE_SIZE - 1) / TILE_SIZE)
+    , epsilon(epsilon)
+    , tiles(tilesX * tilesY) {
+}
+
+void MetaballField::invalidate() {
+    for (auto& tile : tiles) {
+        tile.valid = false;
+    }
+}
+
+const std::vector<sf::IntRect>& MetaballField::updateTiles(std::span<const Blob> blobs) {
+    lastFrame = Stats{};
+    dirtyTiles.clear();
+    binBlobs(blobs);
+
+    for (unsigned int ty = 0; ty < tilesY; ++ty) {
+        for (unsigned int tx = 0; tx < tilesX; ++tx) {
+            Tile& tile = tiles[ty * tilesX + tx];
+
+            if (tile.valid && matchesCache(tile)) {
+                ++lastFrame.tilesReused;
+                continue;
+            }
+
+            // Keep the state the pixels are drawn from, so slow drift
+            // accumulates against it instead of slipping through frame by frame
+            std::swap(tile.cached, tile.current);
+            tile.valid = true;
+            ++lastFrame.tilesEvaluated;
+
+            int left = static_cast<int>(tx * TILE_SIZE);
+            int top = static_cast<int>(ty * TILE_SIZE);
+            dirtyTiles.emplace_back(left, top,
+                                    static_cast<int>(std::min(TILE_SIZE, width - left)),
+                                    static_cast<int>(std::min(TILE_SIZE, height - top)));
+        }
+    }
+
+    total.tilesEvaluated += lastFrame.tilesEvaluated;
+    total.tilesReused += lastFrame.tilesReused;
+    return dirtyTiles;
+}
+
+const std::vector<sf::Uint8>& MetaballField::render(std::span<const Blob> blobs) {
+    // Only the CPU path needs a pixel buffer, so allocate it on first use
+    if (pixels.empty()) {
+        pixels.assign(static_cast<std::size_t>(width) * height * 4, 0);
+    }
+
+    for (const auto& rect : updateTiles(blobs)) {
+        const Tile& tile = tiles[(rect.top / TILE_SIZE) * tilesX + rect.left / TILE_SIZE];
+        evaluateTile(rect, tile.cached);
+    }
+    return pixels;
+}
+
+void MetaballField::binBlobs(std::span<const Blob> blobs) {
+    for (auto& tile : tiles) {
+        tile.current.clear(); // Keeps capacity between frames
+    }
+
+    // Blobs are binned in list order, so each tile sums them in the same
+    // order a full render would
+    for (const auto& blob : blobs) {
+        sf::Vector2f position = blob.getPosition();
+        float reach = blob.getRadius() * SUPPORT;
+
+        // Tile range of the support square, pixel centers at +0.5
+        float left = (position.x - reach - 0.5f) / TILE_SIZE;
+        float right = (position.x + reach - 0.5f) / TILE_SIZE;
+        float top = (position.y - reach - 0.5f) / TILE_SIZE;
+        float bottom = (position.y + reach - 0.5f) / TILE_SIZE;
+
+        if (right < 0.0f || bottom < 0.0f || left >= tilesX || top >= tilesY) {
+            continue;
+        }
+
+        auto x0 = static_cast<unsigned int>(std::max(0.0f, std::floor(left)));
+        auto y0 = static_cast<unsigned int>(std::max(0.0f, std::floor(top)));
+        auto x1 = std::min(tilesX - 1, static_cast<unsigned int>(right));
+        auto y1 = std::min(tilesY - 1, static_cast<unsigned int>(bottom));
+
+        BlobState state{blob.getId(), position, blob.getRadius(), blob.getColor()};
+        for (unsigned int ty = y0; ty <= y1; ++ty) {
+            for (unsigned int tx = x0; tx <= x1; ++tx) {
+                tiles[ty * tilesX + tx].current.push_back(state);
+            }
+        }
+    }
+}
+
+bool MetaballField::matchesCache(const Tile& tile) const {
+    // A blob entering or leaving the support region changes the list
+    if (tile.current.size() != tile.cached.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < tile.current.size(); ++i) {
+        const BlobState& now = tile.current[i];
+        const BlobState& then = tile.cached[i];
+
+        if (now.id != then.id || now.color != then.color) {
+            return false;
+        }
+        if (std::abs(now.position.x - then.position.x) > epsilon ||
+            std::abs(now.position.y - then.position.y) > epsilon ||
+            std::abs(now.radius - then.radius) > epsilon) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MetaballField::evaluateTile(const sf::IntRect& rect, const std::vector<BlobState>& contributors) {
+    unsigned int x0 = rect.left;
+    unsigned int y0 = rect.top;
+    unsigned int x1 = rect.left + rect.width;
+    unsigned int y1 = rect.top + rect.height;
+    const float threshold = 1.0f;
+
+    for (unsigned int y = y0; y < y1; ++y) {
+        sf::Uint8* out = &pixels[(static_cast<std::size_t>(y) * width + x0) * 4];
+
+        for (unsigned int x = x0; x < x1; ++x, out += 4) {
+            float px = x + 0.5f;
+            float py = y + 0.5f;
+
+            float totalInfluence = 0.0f;
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+
+            for (const auto& blob : contributors) {
+                float value = influence(px, py, blob.position, blob.radius);
+                totalInfluence += value;
+                r += blob.color.r / 255.0f * value;
+                g += blob.color.g / 255.0f * value;
+                b += blob.color.b / 255.0f * value;
+                a += blob.color.a / 255.0f * value;
+            }
+
+            if (totalInfluence < 0.1f) {
+                out[0] = out[1] = out[2] = out[3] = 0;
+                continue;
+            }
+
+            // Normalize color with influence weighting
+            r /= totalInfluence;
+            g /= totalInfluence;
+            b /= totalInfluence;
+            a /= totalInfluence;
+
+            // Smooth transparent edges
+            float alpha = std::sqrt(smoothstep(0.0f, threshold, totalInfluence));
+            float edgeSoftness = smoothstep(threshold * 0.3f, threshold * 1.2f, totalInfluence);
+            alpha = alpha * 0.5f + (alpha - alpha * 0.5f) * edgeSoftness;
+
+            // 3D shading and rim lighting
+            float centerInfluence = smoothstep(threshold, threshold * 2.5f, totalInfluence);
+            float rimLight = 1.0f - smoothstep(threshold * 0.9f, threshold * 1.1f, totalInfluence);
+            float shade = 0.6f + 0.4f * centerInfluence;
+
+            out[0] = toByte(r * shade + 0.1f * rimLight);
+            out[1] = toByte(g * shade + 0.1f * rimLight);
+            out[2] = toByte(b * shade + 0.1f * rimLight);
+            out[3] = toByte(alpha * a);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Blob.h"
+
+// Per-tile cache for the metaball field. The frame is split into tiles; each
+// tile remembers the blobs it was last drawn with and only needs redrawing when
+// one of them moved or resized beyond `epsilon`, changed color, or entered/left
+// the tile's support region. Unchanged tiles keep their cached pixels.
+//
+// MetaballRenderer redraws dirty tiles with Shaders/metaball.frag. render() is
+// a CPU port of that shader driven by the same cache, which lets tests compare
+// cached output against a full re-render without a GL context.
+class MetaballField {
+public:
+    static constexpr unsigned int TILE_SIZE = 32;
+    static constexpr float SUPPORT = 3.0f; // Influence is zero beyond 3 radii
+
+    struct Stats {
+        std::uint64_t tilesEvaluated = 0;
+        std::uint64_t tilesReused = 0;
+
+        double hitRate() const {
+            auto total = tilesEvaluated + tilesReused;
+            return total > 0 ? static_cast<double>(tilesReused) / total : 0.0;
+        }
+    };
+
+    MetaballField(unsigned int width, unsigned int height, float epsilon = 0.25f);
+
+    void invalidate(); // Forces a full redraw on the next frame, e.g. after a reset
+
+    // Compares this frame's blobs against each tile's cache and returns the
+    // pixel rects that must be redrawn. Their cache is updated on the
+    // assumption that the caller redraws them before the next call.
+    const std::vector<sf::IntRect>& updateTiles(std::span<const Blob> blobs);
+
+    // CPU reference renderer: updateTiles() plus evaluating the dirty tiles
+    const std::vector<sf::Uint8>& render(std::span<const Blob> blobs);
+    const std::vector<sf::Uint8>& getPixels() const { return pixels; }
+
+    const Stats& getLastFrameStats() const { return lastFrame; }
+    const Stats& getTotalStats() const { return total; }
+
+    unsigned int getWidth() const { return width; }
+    unsigned int getHeight() const { return height; }
+
+private:
+    struct BlobState {
+        std::uint32_t id;
+        sf::Vector2f position;
+        float radius;
+        sf::Color color;
+    };
+
+    struct Tile {
+        std::vector<BlobState> cached;  // State the tile's pixels were computed from
+        std::vector<BlobState> current; // Contributors this frame
+        bool valid = false;
+    };
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int tilesX;
+    unsigned int tilesY;
+    float epsilon;
+
+    std::vector<Tile> tiles;
+    std::vector<sf::IntRect> dirtyTiles;
+    std::vector<sf::Uint8> pixels; // CPU reference output, allocated by render()
+
+    Stats lastFrame;
+    Stats total;
+
+    void binBlobs(std::span<const Blob> blobs);
+    bool matchesCache(const Tile& tile) const;
+    void evaluateTile(const sf::IntRect& rect, const std::vector<BlobState>& contributors);
+};
@@ -0,0 +1,64 @@
+#include "MetaballRenderer.h"
+#include <algorithm>
+#include <span>
+#include <string>
+
+MetaballRenderer::MetaballRenderer(unsigned int width, unsigned int height)
+    : field(width, height)
+    , tileQuads(sf::Triangles) {
+}
+
+bool MetaballRenderer::create() {
+    if (!target.create(field.getWidth(), field.getHeight())) {
+        return false;
+    }
+
+    target.clear(sf::Color::Transparent);
+    target.display();
+    field.invalidate();
+    return true;
+}
+
+void MetaballRenderer::render(sf::Shader& shader, const std::vector<Blob>& blobs) {
+    std::span<const Blob> drawn(blobs.data(), std::min(blobs.size(), MAX_BLOBS));
+
+    const auto& dirtyTiles = field.updateTiles(drawn);
+    if (dirtyTiles.empty()) {
+        return;
+    }
+
+    // Two triangles per dirty tile, in the target's pixel coordinates
+    tileQuads.clear();
+    for (const auto& tile : dirtyTiles) {
+        sf::Vector2f topLeft(tile.left, tile.top);
+        sf::Vector2f bottomRight(tile.left + tile.width, tile.top + tile.height);
+        sf::Vector2f topRight(bottomRight.x, topLeft.y);
+        sf::Vector2f bottomLeft(topLeft.x, bottomRight.y);
+
+        for (const auto& corner : {topLeft, topRight, bottomLeft, topRight, bottomRight, bottomLeft}) {
+            tileQuads.append(sf::Vertex(corner));
+        }
+    }
+
+    // Set shader uniforms
+    shader.setUniform("blobCount", static_cast<int>(drawn.size()));
+
+    // Pass blob data to shader
+    for (std::size_t i = 0; i < drawn.size(); ++i) {
+        std::string posName = "blobPositions[" + std::to_string(i) + "]";
+        std::string radiusName = "blobRadii[" + std::to_string(i) + "]";
+        std::string colorName = "blobColors[" + std::to_string(i) + "]";
+
+        shader.setUniform(posName, drawn[i].getPosition());
+        shader.setUniform(radiusName, drawn[i].getRadius());
+        shader.setUniform(colorName, sf::Glsl::Vec4(drawn[i].getColor()));
+    }
+
+    // Replace the tiles' cached pixels outright; blending happens when compositing
+    sf::RenderStates states;
+    states.shader = &shader;
+    states.blendMode = sf::BlendNone;
+
+    target.draw(tileQuads, states);
+    target.display();
+}
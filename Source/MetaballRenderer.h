@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+#include "Blob.h"
+#include "MetaballField.h"
+
+// Keeps the metaball shader's output in a render texture between frames and
+// redraws only the tiles MetaballField reports as dirty.
+class MetaballRenderer {
+public:
+    static constexpr std::size_t MAX_BLOBS = 100; // Size of the uniform arrays in metaball.frag
+
+    MetaballRenderer(unsigned int width, unsigned int height);
+
+    bool create(); // Needs a GL context
+
+    // Blobs past MAX_BLOBS are neither drawn nor tracked by the tile cache
+    void render(sf::Shader& shader, const std::vector<Blob>& blobs);
+    void invalidate() { field.invalidate(); } // Forces a full redraw, e.g. after a reset
+
+    const sf::Texture& getTexture() const { return target.getTexture(); }
+    const MetaballField::Stats& getLastFrameStats() const { return field.getLastFrameStats(); }
+
+private:
+    MetaballField field;
+    sf::RenderTexture target;
+    sf::VertexArray tileQuads;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Tunable physics constants. Defaults reproduce the interactive simulation.
+struct SimulationParams {
+    unsigned int width = 1280;
+    unsigned int height = 720;
+    int numBlobs = 30;
+
+    float gravityStrength = 2000.0f;    // Strong gravity for clear attraction
+    float minDistance = 20.0f;          // Minimum distance to prevent extreme forces
+    float damping = 0.995f;             // Verlet velocity damping per step
+    float collisionWindow = 150.0f;     // Pairs further apart than this skip collision handling
+    float minRadius = 10.0f;
+    float maxRadius = 40.0f;
+
+    std::uint32_t seed = 0;
+};
@@ -1,17 +1,55 @@
+#include "BatchRunner.h"
 #include "BlobSimulation.h"
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
+#include <cstring>
+
+// Headless parameter sweep: blob_sim --batch SPEC [OUTPUT.csv] [THREADS]
+static int runBatchMode(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " --batch SPEC [OUTPUT.csv] [THREADS]" << std::endl;
+        return 1;
+    }
+    
+    std::ifstream specFile(argv[2]);
+    if (!specFile) {
+        std::cerr << "Failed to open sweep spec: " << argv[2] << std::endl;
+        return 1;
+    }
+    
+    auto runs = SweepSpec::parse(specFile).expand();
+    unsigned int threads = argc >= 5 ? std::atoi(argv[4]) : 0;
+    
+    if (argc >= 4) {
+        std::ofstream out(argv[3]);
+        if (!out) {
+            std::cerr << "Failed to open output: " << argv[3] << std::endl;
+            return 1;
+        }
+        runBatch(runs, threads, out);
+    } else {
+        runBatch(runs, threads, std::cout);
+    }
+    
+    std::cerr << "Completed " << runs.size() << " runs" << std::endl;
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
     unsigned int width = 1280;
     unsigned int height = 720;
     
-    if (argc >= 3) {
-        width = std::atoi(argv[1]);
-        height = std::atoi(argv[2]);
-    }
-    
     try {
+        if (argc >= 2 && std::strcmp(argv[1], "--batch") == 0) {
+            return runBatchMode(argc, argv);
+        }
+        
+        if (argc >= 3) {
+            width = std::atoi(argv[1]);
+            height = std::atoi(argv[2]);
+        }
+        
         BlobSimulation simulation(width, height);
         simulation.run();
     } catch (const std::exception& e) {
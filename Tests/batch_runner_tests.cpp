@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include "../Source/BatchRunner.h"
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+
+class BatchRunnerTest : public ::testing::Test {
+protected:
+    static SweepSpec parse(const std::string& text) {
+        std::istringstream in(text);
+        return SweepSpec::parse(in);
+    }
+
+    // Accepts `limit` characters, then fails every write
+    class FailingBuffer : public std::streambuf {
+    public:
+        explicit FailingBuffer(std::size_t limit) : remaining(limit) {}
+
+    protected:
+        int_type overflow(int_type ch) override {
+            if (remaining == 0) {
+                return traits_type::eof();
+            }
+            --remaining;
+            return ch;
+        }
+
+    private:
+        std::size_t remaining;
+    };
+};
+
+TEST_F(BatchRunnerTest, ParseRangesListsAndRunKeys) {
+    auto spec = parse(
+        "# comment\n"
+        "steps = 10\n"
+        "seeds = 2\n"
+        "seed = 7\n"
+        "gravityStrength = 1000:2000:500  # inclusive\n"
+        "damping = 0.99, 0.995\n");
+
+    EXPECT_EQ(spec.steps, 10);
+    EXPECT_EQ(spec.seedsPerPoint, 2);
+    EXPECT_EQ(spec.baseSeed, 7u);
+    ASSERT_EQ(spec.axes.size(), 2u);
+    EXPECT_EQ(spec.axes[0].second, (std::vector<double>{1000.0, 1500.0, 2000.0}));
+    EXPECT_EQ(spec.axes[1].second.size(), 2u);
+}
+
+TEST_F(BatchRunnerTest, ParseRejectsBadInput) {
+    EXPECT_THROW(parse("gravity = 1\n"), std::runtime_error);
+    EXPECT_THROW(parse("damping = abc\n"), std::runtime_error);
+    EXPECT_THROW(parse("damping 0.99\n"), std::runtime_error);
+    EXPECT_THROW(parse("minDistance = 10:5:1\n"), std::runtime_error);
+    EXPECT_THROW(parse("steps = 1, 2\n"), std::runtime_error);
+}
+
+TEST_F(BatchRunnerTest, ParseRejectsOutOfRangeValues) {
+    EXPECT_THROW(parse("minRadius = 0, 10\n"), std::runtime_error);
+    EXPECT_THROW(parse("width = 0\n"), std::runtime_error);
+    EXPECT_THROW(parse("height = -720\n"), std::runtime_error);
+    EXPECT_THROW(parse("numBlobs = 5.5\n"), std::runtime_error);
+    EXPECT_THROW(parse("steps = 10.7\n"), std::runtime_error);
+    EXPECT_THROW(parse("seeds = -3\n"), std::runtime_error);
+    EXPECT_THROW(parse("dt = 0\n"), std::runtime_error);
+    EXPECT_THROW(parse("damping = 1.5\n"), std::runtime_error);
+    EXPECT_THROW(parse("gravityStrength = nan\n"), std::runtime_error);
+
+    // The error names the offending line
+    try {
+        parse("steps = 10\n\nnumBlobs = 4, 5.5\n");
+        FAIL() << "expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+    }
+}
+
+TEST_F(BatchRunnerTest, ParseRejectsValuesThatOverflowTheirField) {
+    EXPECT_THROW(parse("width = 1e12\n"), std::runtime_error);
+    EXPECT_THROW(parse("numBlobs = 3e9\n"), std::runtime_error);
+    EXPECT_THROW(parse("seed = 1e10\n"), std::runtime_error);
+    EXPECT_THROW(parse("steps = 1e10\n"), std::runtime_error);
+    EXPECT_NO_THROW(parse("seed = 4294967295\n"));
+
+    // Ranges and lists are capped before they are expanded
+    EXPECT_THROW(parse("gravityStrength = 0:1e12:1e-3\n"), std::runtime_error);
+    EXPECT_THROW(parse("seeds = 2000\nnumBlobs = 0:999:1\n").expand(), std::runtime_error);
+}
+
+TEST_F(BatchRunnerTest, ParseRejectsDuplicateKeys) {
+    try {
+        parse("damping = 0.5\nsteps = 10\ndamping = 0.9, 0.99\n");
+        FAIL() << "expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        std::string message = e.what();
+        EXPECT_NE(message.find("line 3"), std::string::npos) << message;
+        EXPECT_NE(message.find("line 1"), std::string::npos) << message;
+    }
+
+    EXPECT_THROW(parse("steps = 10\nsteps = 20\n"), std::runtime_error);
+}
+
+TEST_F(BatchRunnerTest, ExpandRejectsMinRadiusAboveMaxRadius) {
+    EXPECT_THROW(parse("minRadius = 10, 30\nmaxRadius = 20, 40\n").expand(), std::runtime_error);
+    EXPECT_THROW(parse("minRadius = 50\n").expand(), std::runtime_error); // Default maxRadius is 40
+    EXPECT_EQ(parse("minRadius = 10, 20\nmaxRadius = 20, 40\n").expand().size(), 4u);
+}
+
+TEST_F(BatchRunnerTest, ExpandIsCartesianProductTimesSeeds) {
+    auto runs = parse(
+        "seeds = 2\n"
+        "gravityStrength = 1000, 2000, 3000\n"
+        "numBlobs = 5, 10\n").expand();
+
+    ASSERT_EQ(runs.size(), 12u);
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        EXPECT_EQ(runs[i].index, i);
+    }
+
+    // Last axis varies fastest, seeds innermost
+    EXPECT_FLOAT_EQ(runs[0].params.gravityStrength, 1000.0f);
+    EXPECT_EQ(runs[0].params.numBlobs, 5);
+    EXPECT_EQ(runs[0].params.seed, 1u);
+    EXPECT_EQ(runs[1].params.seed, 2u);
+    EXPECT_EQ(runs[2].params.numBlobs, 10);
+    EXPECT_FLOAT_EQ(runs[11].params.gravityStrength, 3000.0f);
+
+    // Unswept fields keep their defaults
+    EXPECT_FLOAT_EQ(runs[0].params.damping, SimulationParams{}.damping);
+}
+
+TEST_F(BatchRunnerTest, SameSeedIsDeterministic) {
+    BatchRun run;
+    run.params.numBlobs = 12;
+    run.params.seed = 42;
+    run.steps = 50;
+
+    // A reused world must give the same result as a fresh one
+    BlobWorld reused{SimulationParams{}};
+    runSimulation(reused, run);
+    auto first = runSimulation(reused, run);
+
+    BlobWorld fresh{SimulationParams{}};
+    auto second = runSimulation(fresh, run);
+
+    EXPECT_DOUBLE_EQ(first.kineticEnergy, second.kineticEnergy);
+    EXPECT_EQ(first.clusterCount, second.clusterCount);
+    EXPECT_DOUBLE_EQ(first.overlap, second.overlap);
+    EXPECT_GT(first.kineticEnergy, 0.0);
+    EXPECT_GE(first.clusterCount, 1);
+    EXPECT_LE(first.clusterCount, 12);
+}
+
+TEST_F(BatchRunnerTest, ParallelBatchWritesOneRowPerRun) {
+    auto runs = parse(
+        "steps = 20\n"
+        "seeds = 3\n"
+        "numBlobs = 6\n"
+        "damping = 0.99, 0.995\n").expand();
+
+    std::ostringstream parallel;
+    runBatch(runs, 4, parallel);
+
+    std::istringstream lines(parallel.str());
+    std::string line;
+    std::getline(lines, line);
+    EXPECT_EQ(line.rfind("run,seed,", 0), 0u);
+
+    std::vector<int> seen(runs.size(), 0);
+    std::size_t rows = 0;
+    while (std::getline(lines, line)) {
+        std::size_t index = std::stoul(line.substr(0, line.find(',')));
+        ASSERT_LT(index, runs.size());
+        ++seen[index];
+        ++rows;
+    }
+
+    EXPECT_EQ(rows, runs.size());
+    for (int count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST_F(BatchRunnerTest, WorkerExceptionIsRethrownAfterJoin) {
+    auto runs = parse(
+        "steps = 5\n"
+        "seeds = 8\n"
+        "numBlobs = 4\n").expand();
+
+    std::ostringstream header;
+    writeCsvHeader(header);
+
+    // The header goes through, then the first row written on a worker throws
+    FailingBuffer buffer(header.str().size());
+    std::ostream csv(&buffer);
+    csv.exceptions(std::ios::badbit);
+
+    EXPECT_THROW(runBatch(runs, 4, csv), std::ios_base::failure);
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include "../Source/BlobCommandQueue.h"
+#include "../Source/BlobWorld.h"
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class BlobCommandQueueTest : public ::testing::Test {
+protected:
+    // Encodes producer and sequence number into the blob id so the consumer can verify ordering
+    static std::uint32_t encode(std::uint32_t producer, std::uint32_t seq) { return (producer << 24) | seq; }
+};
+
+TEST_F(BlobCommandQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    BlobCommandQueue queue(100);
+    EXPECT_EQ(queue.capacity(), 128u);
+}
+
+TEST_F(BlobCommandQueueTest, PushDrainPreservesOrder) {
+    BlobCommandQueue queue(8);
+    for (std::uint32_t i = 1; i <= 5; ++i) {
+        EXPECT_TRUE(queue.push(BlobCommand::remove(i)));
+    }
+
+    std::vector<BlobCommand> out;
+    EXPECT_EQ(queue.drain(out, 3), 3u);
+    EXPECT_EQ(queue.drain(out, 100), 2u);
+    ASSERT_EQ(out.size(), 5u);
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(out[i].blobId, i + 1);
+    }
+    EXPECT_EQ(queue.drain(out, 100), 0u);
+}
+
+TEST_F(BlobCommandQueueTest, OverflowIsCounted) {
+    BlobCommandQueue queue(4);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(BlobCommand::remove(i)));
+    }
+    EXPECT_FALSE(queue.push(BlobCommand::remove(99)));
+
+    std::vector<BlobCommand> bulk(3, BlobCommand::remove(7));
+    EXPECT_FALSE(queue.pushBulk(bulk));
+
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.pushed, 4u);
+    EXPECT_EQ(stats.dropped, 4u);
+
+    // Draining frees space again
+    std::vector<BlobCommand> out;
+    queue.drain(out, 2);
+    EXPECT_FALSE(queue.pushBulk(bulk));
+    queue.drain(out, 1);
+    EXPECT_TRUE(queue.pushBulk(bulk));
+
+    stats = queue.getStats();
+    EXPECT_EQ(stats.drained, 3u);
+    EXPECT_EQ(stats.batches, 2u);
+    EXPECT_EQ(stats.peakBatch, 2u);
+}
+
+TEST_F(BlobCommandQueueTest, BulkLargerThanCapacityIsRejected) {
+    BlobCommandQueue queue(4);
+    std::vector<BlobCommand> bulk(5, BlobCommand::remove(1));
+    EXPECT_FALSE(queue.pushBulk(bulk));
+    EXPECT_EQ(queue.getStats().dropped, 5u);
+}
+
+TEST_F(BlobCommandQueueTest, DiscardDropsOnlyWhatWasQueued) {
+    BlobCommandQueue queue(8);
+    for (std::uint32_t i = 1; i <= 3; ++i) {
+        queue.push(BlobCommand::remove(i));
+    }
+    EXPECT_EQ(queue.discard(), 3u);
+
+    std::vector<BlobCommand> out;
+    EXPECT_EQ(queue.drain(out, 100), 0u);
+
+    queue.push(BlobCommand::remove(4));
+    EXPECT_EQ(queue.drain(out, 100), 1u);
+
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.discarded, 3u);
+    EXPECT_EQ(stats.drained, 1u);
+}
+
+TEST_F(BlobCommandQueueTest, DiscardReturnsWhileProducersKeepPushing) {
+    BlobCommandQueue queue(64);
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&] {
+            while (!stop.load()) {
+                if (!queue.push(BlobCommand::remove(1))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each call is bounded by the queue's length at entry
+    std::vector<BlobCommand> out;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_LE(queue.discard(), queue.capacity());
+        out.clear();
+        queue.drain(out, 8);
+    }
+
+    stop.store(true);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+}
+
+TEST_F(BlobCommandQueueTest, ManyProducersStress) {
+    const std::uint32_t numProducers = 8;
+    const std::uint32_t perProducer = 20000;
+    BlobCommandQueue queue(1024);
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < numProducers; ++p) {
+        producers.emplace_back([&, p] {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            std::uint32_t seq = 0;
+            while (seq < perProducer) {
+                // Mix single and bulk pushes; retry on overflow so every command arrives
+                if (seq % 7 == 0 && seq + 4 <= perProducer) {
+                    BlobCommand bulk[4];
+                    for (std::uint32_t k = 0; k < 4; ++k) {
+                        bulk[k] = BlobCommand::remove(encode(p, seq + k));
+                    }
+                    if (queue.pushBulk(bulk)) {
+                        seq += 4;
+                        continue;
+                    }
+                } else if (queue.push(BlobCommand::remove(encode(p, seq)))) {
+                    ++seq;
+                    continue;
+                }
+                std::this_thread::yield(); // Full; let the consumer catch up
+            }
+        });
+    }
+
+    start.store(true);
+
+    std::vector<std::uint32_t> nextSeq(numProducers, 0);
+    std::vector<BlobCommand> batch;
+    std::size_t received = 0;
+    bool inOrder = true;
+    while (received < numProducers * perProducer) {
+        batch.clear();
+        received += queue.drain(batch, 256);
+        for (const auto& command : batch) {
+            std::uint32_t p = command.blobId >> 24;
+            std::uint32_t seq = command.blobId & 0xFFFFFF;
+            inOrder = inOrder && p < numProducers && seq == nextSeq[p];
+            if (p < numProducers) {
+                nextSeq[p] = seq + 1;
+            }
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(inOrder);
+    for (std::uint32_t p = 0; p < numProducers; ++p) {
+        EXPECT_EQ(nextSeq[p], perProducer);
+    }
+
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.pushed, static_cast<std::uint64_t>(numProducers) * perProducer);
+    EXPECT_EQ(stats.drained, stats.pushed);
+    EXPECT_LE(stats.peakBatch, 256u);
+}
+
+TEST_F(BlobCommandQueueTest, ApplySpawnImpulseRemove) {
+    std::vector<Blob> blobs;
+    blobs.emplace_back(100.0f, 100.0f, 20.0f, sf::Color::Red);
+    blobs.back().setId(1);
+
+    std::vector<BlobCommand> commands = {
+        BlobCommand::impulse(2, sf::Vector2f(1000.0f, 0.0f)), // Targets a blob spawned in this batch
+        BlobCommand::spawn(2, sf::Vector2f(200.0f, 200.0f), sf::Vector2f(0.0f, 0.0f), 10.0f, sf::Color::Blue),
+        BlobCommand::remove(1),
+        BlobCommand::remove(1),
+        BlobCommand::remove(42), // Unknown ids are ignored
+    };
+
+    // Spawn, impulse and both removes of blob 1 matched; only id 42 missed
+    BlobCommandScratch scratch;
+    auto result = applyBlobCommands(commands, blobs, 0.016f, scratch);
+    EXPECT_EQ(result.applied, 4u);
+    EXPECT_EQ(result.rejected, 0u);
+    ASSERT_EQ(blobs.size(), 1u);
+    EXPECT_EQ(blobs[0].getId(), 2u);
+    EXPECT_EQ(blobs[0].getColor(), sf::Color::Blue);
+
+    // The impulse shows up as velocity on the next integration step
+    blobs[0].update(0.016f, sf::Vector2u(800, 600), 0.995f);
+    EXPECT_GT(blobs[0].getX(), 200.0f);
+    EXPECT_FLOAT_EQ(blobs[0].getY(), 200.0f);
+}
+
+TEST_F(BlobCommandQueueTest, ApplyRejectsInvalidCommands) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    std::vector<Blob> blobs;
+    blobs.emplace_back(100.0f, 100.0f, 20.0f, sf::Color::Red);
+    blobs.back().setId(1);
+
+    std::vector<BlobCommand> commands = {
+        BlobCommand::spawn(2, sf::Vector2f(200.0f, 200.0f), sf::Vector2f(0.0f, 0.0f), 0.0f, sf::Color::Blue),
+        BlobCommand::spawn(3, sf::Vector2f(200.0f, 200.0f), sf::Vector2f(0.0f, 0.0f), -5.0f, sf::Color::Blue),
+        BlobCommand::spawn(4, sf::Vector2f(nan, 200.0f), sf::Vector2f(0.0f, 0.0f), 10.0f, sf::Color::Blue),
+        BlobCommand::spawn(5, sf::Vector2f(200.0f, 200.0f), sf::Vector2f(inf, 0.0f), 10.0f, sf::Color::Blue),
+        BlobCommand::spawn(6, sf::Vector2f(200.0f, 200.0f), sf::Vector2f(0.0f, 0.0f), inf, sf::Color::Blue),
+        BlobCommand::impulse(1, sf::Vector2f(0.0f, nan)),
+        BlobCommand{}, // Default-constructed commands are not spawns
+        BlobCommand::spawn(7, sf::Vector2f(300.0f, 300.0f), sf::Vector2f(0.0f, 0.0f), 10.0f, sf::Color::Green),
+    };
+
+    BlobCommandScratch scratch;
+    auto result = applyBlobCommands(commands, blobs, 0.016f, scratch);
+    EXPECT_EQ(result.applied, 1u);
+    EXPECT_EQ(result.rejected, 7u);
+    ASSERT_EQ(blobs.size(), 2u);
+    EXPECT_EQ(blobs[1].getId(), 7u);
+    EXPECT_EQ(blobs[0].getPreviousPosition(), sf::Vector2f(100.0f, 100.0f)); // The NaN impulse never landed
+}
+
+TEST_F(BlobCommandQueueTest, WorldCountsRejectedCommandsAndStaysFinite) {
+    SimulationParams params;
+    params.numBlobs = 5;
+    BlobWorld world(params);
+    world.initialize(1.0f / 60.0f);
+
+    auto& queue = world.getCommandQueue();
+    queue.push(BlobCommand::spawn(queue.reserveBlobId(), sf::Vector2f(400.0f, 300.0f), sf::Vector2f(0.0f, 0.0f), 0.0f,
+                                  sf::Color::Red));
+    for (int i = 0; i < 10; ++i) {
+        world.step(1.0f / 60.0f);
+    }
+
+    EXPECT_EQ(queue.getStats().rejected, 1u);
+    EXPECT_EQ(world.getBlobs().size(), 5u);
+    EXPECT_TRUE(std::isfinite(world.measure(1.0f / 60.0f).kineticEnergy));
+}
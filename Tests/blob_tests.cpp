@@ -41,7 +41,7 @@ TEST_F(BlobTest, ApplyForce) {
     sf::Vector2f initialPos = blob.getPosition();
     
     blob.applyForce(sf::Vector2f(100.0f, 0.0f));
-    blob.update(0.016f, sf::Vector2u(800, 600)); // ~60Hz frame
+    blob.update(0.016f, sf::Vector2u(800, 600), 0.995f); // ~60Hz frame
     
     EXPECT_GT(blob.getX(), initialPos.x);
     EXPECT_FLOAT_EQ(blob.getY(), initialPos.y);
@@ -52,12 +52,12 @@ TEST_F(BlobTest, WrapBounds) {
     
     // Test horizontal wrap
     Blob blob1(-100.0f, 300.0f, 20.0f, sf::Color::Cyan);
-    blob1.update(0.016f, windowSize);
+    blob1.update(0.016f, windowSize, 0.995f);
     EXPECT_GT(blob1.getX(), 600.0f);
     
     // Test vertical wrap
     Blob blob2(400.0f, -100.0f, 20.0f, sf::Color::Magenta);
-    blob2.update(0.016f, windowSize);
+    blob2.update(0.016f, windowSize, 0.995f);
     EXPECT_GT(blob2.getY(), 400.0f);
 }
 
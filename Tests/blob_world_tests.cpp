@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "../Source/BlobWorld.h"
+
+class BlobWorldTest : public ::testing::Test {
+};
+
+TEST_F(BlobWorldTest, InitialSpeedDoesNotDependOnDt) {
+    SimulationParams params;
+    params.numBlobs = 6;
+    params.seed = 5;
+
+    BlobWorld coarse(params);
+    coarse.initialize(1.0f / 30.0f);
+    BlobWorld fine(params);
+    fine.initialize(1.0f / 240.0f);
+
+    auto a = coarse.measure(1.0f / 30.0f);
+    auto b = fine.measure(1.0f / 240.0f);
+    EXPECT_NEAR(a.kineticEnergy, b.kineticEnergy, a.kineticEnergy * 1e-3);
+}
+
+TEST_F(BlobWorldTest, ResetDiscardsQueuedCommands) {
+    SimulationParams params;
+    params.numBlobs = 3;
+    BlobWorld world(params);
+    world.initialize(1.0f / 60.0f);
+
+    // A Space-key spawn pending when R is pressed must not reach the new scene
+    world.spawnRandomBlob();
+    world.reset(params, 1.0f / 60.0f);
+    world.step(1.0f / 60.0f);
+
+    EXPECT_EQ(world.getBlobs().size(), 3u);
+}
+
+TEST_F(BlobWorldTest, MeasureCountsClustersAndOverlap) {
+    SimulationParams params;
+    params.numBlobs = 0;
+    BlobWorld world(params);
+    world.initialize(1.0f / 60.0f);
+
+    // Two touching blobs and one far away, all at rest
+    auto& queue = world.getCommandQueue();
+    queue.push(BlobCommand::spawn(1, sf::Vector2f(100.0f, 100.0f), sf::Vector2f(0.0f, 0.0f), 20.0f, sf::Color::Red));
+    queue.push(BlobCommand::spawn(2, sf::Vector2f(130.0f, 100.0f), sf::Vector2f(0.0f, 0.0f), 20.0f, sf::Color::Red));
+    queue.push(BlobCommand::spawn(3, sf::Vector2f(600.0f, 400.0f), sf::Vector2f(0.0f, 0.0f), 20.0f, sf::Color::Red));
+    world.step(0.0f);
+
+    auto metrics = world.measure(1.0f / 60.0f);
+    EXPECT_EQ(metrics.clusterCount, 2);
+    EXPECT_NEAR(metrics.overlap, 10.0, 0.5);
+}
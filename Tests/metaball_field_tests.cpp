@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "../Source/MetaballField.h"
+#include "../Source/BlobWorld.h"
+#include <algorithm>
+#include <cstdlib>
+
+class MetaballFieldTest : public ::testing::Test {
+protected:
+    static int maxChannelDifference(const std::vector<sf::Uint8>& a, const std::vector<sf::Uint8>& b) {
+        int worst = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            worst = std::max(worst, std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+        }
+        return worst;
+    }
+
+    struct VisibleError {
+        double mean = 0.0;
+        double noticeableFraction = 0.0; // Pixels off by more than 12/255
+    };
+
+    // Error after alpha blending onto black, so nearly transparent color jumps
+    // at the field's 0.1 cutoff don't count as differences
+    static VisibleError visibleError(const std::vector<sf::Uint8>& a, const std::vector<sf::Uint8>& b) {
+        double sum = 0.0;
+        std::size_t noticeable = 0;
+        for (std::size_t i = 0; i < a.size(); i += 4) {
+            int worst = std::abs(static_cast<int>(a[i + 3]) - static_cast<int>(b[i + 3]));
+            for (std::size_t c = 0; c < 3; ++c) {
+                worst = std::max(worst, std::abs(a[i + c] * a[i + 3] / 255 - b[i + c] * b[i + 3] / 255));
+            }
+            sum += worst;
+            noticeable += worst > 12 ? 1 : 0;
+        }
+
+        std::size_t count = a.size() / 4;
+        return VisibleError{sum / count, static_cast<double>(noticeable) / count};
+    }
+
+    static std::vector<sf::Uint8> fullRender(const std::vector<Blob>& blobs, unsigned int width, unsigned int height) {
+        MetaballField reference(width, height);
+        return reference.render(blobs);
+    }
+
+    static Blob makeBlob(std::uint32_t id, float x, float y, float radius) {
+        Blob blob(x, y, radius, sf::Color(200, 100, 50));
+        blob.setId(id);
+        return blob;
+    }
+};
+
+TEST_F(MetaballFieldTest, FirstFrameEvaluatesEveryTile) {
+    MetaballField field(100, 70);
+    std::vector<Blob> blobs = {makeBlob(1, 50.0f, 35.0f, 15.0f)};
+
+    field.render(blobs);
+    // 100x70 with 32px tiles is 4x3
+    EXPECT_EQ(field.getLastFrameStats().tilesEvaluated, 12u);
+    EXPECT_EQ(field.getLastFrameStats().tilesReused, 0u);
+
+    // Blob center should be lit, far corner empty
+    const auto& pixels = field.getPixels();
+    EXPECT_GT(pixels[(35 * 100 + 50) * 4 + 3], 0);
+    EXPECT_EQ(pixels[(69 * 100 + 99) * 4 + 3], 0);
+}
+
+TEST_F(MetaballFieldTest, StaticSceneIsFullyCached) {
+    MetaballField field(256, 256);
+    std::vector<Blob> blobs = {makeBlob(1, 60.0f, 60.0f, 20.0f), makeBlob(2, 180.0f, 190.0f, 12.0f)};
+
+    field.render(blobs);
+    field.render(blobs);
+
+    EXPECT_EQ(field.getLastFrameStats().tilesEvaluated, 0u);
+    EXPECT_DOUBLE_EQ(field.getLastFrameStats().hitRate(), 1.0);
+    EXPECT_DOUBLE_EQ(field.getTotalStats().hitRate(), 0.5);
+}
+
+TEST_F(MetaballFieldTest, DirtyTileRectsAreClippedAndInvalidateRedrawsAll) {
+    MetaballField field(100, 70);
+    std::vector<Blob> blobs = {makeBlob(1, 50.0f, 35.0f, 15.0f)};
+
+    const auto& dirty = field.updateTiles(blobs);
+    ASSERT_EQ(dirty.size(), 12u);
+    EXPECT_EQ(dirty.front(), sf::IntRect(0, 0, 32, 32));
+    EXPECT_EQ(dirty.back(), sf::IntRect(96, 64, 4, 6)); // Edge tiles stop at the frame
+
+    EXPECT_TRUE(field.updateTiles(blobs).empty());
+
+    // After a reset the whole frame is redrawn even if the blobs look the same
+    field.invalidate();
+    EXPECT_EQ(field.updateTiles(blobs).size(), 12u);
+}
+
+TEST_F(MetaballFieldTest, OnlyTilesNearMovedBlobAreEvaluated) {
+    MetaballField field(256, 256, 0.25f);
+    std::vector<Blob> blobs = {makeBlob(1, 40.0f, 40.0f, 8.0f), makeBlob(2, 200.0f, 200.0f, 8.0f)};
+    field.render(blobs);
+
+    // Below epsilon: nothing recomputed
+    blobs[0].setPosition(sf::Vector2f(40.1f, 40.0f));
+    field.render(blobs);
+    EXPECT_EQ(field.getLastFrameStats().tilesEvaluated, 0u);
+
+    // Beyond epsilon: only the tiles covering blob 1's old and new support
+    // region (x now reaches into a third tile column), not the other 58
+    blobs[0].setPosition(sf::Vector2f(41.0f, 40.0f));
+    field.render(blobs);
+    EXPECT_EQ(field.getLastFrameStats().tilesEvaluated, 6u);
+
+    // Color and radius changes also invalidate
+    blobs[1].setColor(sf::Color::Green);
+    field.render(blobs);
+    EXPECT_GT(field.getLastFrameStats().tilesEvaluated, 0u);
+
+    blobs[1].setRadius(9.0f);
+    field.render(blobs);
+    EXPECT_GT(field.getLastFrameStats().tilesEvaluated, 0u);
+
+    EXPECT_EQ(maxChannelDifference(field.getPixels(), fullRender(blobs, 256, 256)), 0);
+}
+
+TEST_F(MetaballFieldTest, RemovedBlobClearsItsTiles) {
+    MetaballField field(128, 128);
+    std::vector<Blob> blobs = {makeBlob(1, 64.0f, 64.0f, 10.0f)};
+    field.render(blobs);
+
+    blobs.clear();
+    field.render(blobs);
+
+    const auto& pixels = field.getPixels();
+    EXPECT_TRUE(std::all_of(pixels.begin(), pixels.end(), [](sf::Uint8 v) { return v == 0; }));
+}
+
+TEST_F(MetaballFieldTest, ZeroEpsilonMatchesFullRenderExactly) {
+    SimulationParams params;
+    params.width = 320;
+    params.height = 200;
+    params.numBlobs = 8;
+    params.seed = 3;
+    BlobWorld world(params);
+    world.initialize(1.0f / 60.0f);
+
+    MetaballField field(params.width, params.height, 0.0f);
+    for (int i = 0; i < 30; ++i) {
+        world.step(1.0f / 60.0f);
+        field.render(world.getBlobs());
+    }
+
+    EXPECT_EQ(maxChannelDifference(field.getPixels(), fullRender(world.getBlobs(), params.width, params.height)), 0);
+}
+
+TEST_F(MetaballFieldTest, CachedRenderMatchesFullRenderWithinTolerance) {
+    SimulationParams params;
+    params.width = 320;
+    params.height = 200;
+    params.numBlobs = 10;
+    params.seed = 11;
+    params.damping = 0.9f; // Settle quickly so tiles actually get reused
+    BlobWorld world(params);
+    world.initialize(1.0f / 60.0f);
+
+    MetaballField field(params.width, params.height, 0.25f);
+    for (int i = 0; i < 240; ++i) {
+        world.step(1.0f / 60.0f);
+        field.render(world.getBlobs());
+
+        if (i % 40 == 39) {
+            // The influence function jumps at exactly one radius, so a sub-epsilon
+            // move can flip a thin ring of pixels; the image as a whole stays put
+            auto error = visibleError(field.getPixels(), fullRender(world.getBlobs(), params.width, params.height));
+            EXPECT_LT(error.mean, 1.0) << "step " << i;
+            EXPECT_LT(error.noticeableFraction, 0.01) << "step " << i;
+        }
+    }
+
+    EXPECT_GT(field.getTotalStats().hitRate(), 0.5);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "../Source/MetaballRenderer.h"
+#include "../Source/ShaderManager.h"
+
+// Draws through metaball.vert/frag into a real render texture and reads it
+// back, so it needs a GL context and the Shaders directory next to the binary.
+class MetaballRendererTest : public ::testing::Test {
+protected:
+    ShaderManager shaders;
+    MetaballRenderer renderer{128, 64};
+
+    void SetUp() override {
+        if (!shaders.loadShaders()) {
+            GTEST_SKIP() << "Shaders unavailable (no GL context or Shaders directory)";
+        }
+        if (!renderer.create()) {
+            GTEST_SKIP() << "Render textures unavailable";
+        }
+    }
+
+    sf::Uint8 alphaAt(unsigned int x, unsigned int y) const {
+        return renderer.getTexture().copyToImage().getPixel(x, y).a;
+    }
+
+    static Blob makeBlob(std::uint32_t id, float x, float y, float radius) {
+        Blob blob(x, y, radius, sf::Color::Green);
+        blob.setId(id);
+        return blob;
+    }
+};
+
+TEST_F(MetaballRendererTest, DirtyTileAwayFromOriginIsRedrawn) {
+    // 128x64 is 4x2 tiles; a radius 5 blob reaches 15px, so at x=80 it only
+    // touches tile column 2 and at x=112 only column 3, both in the top row
+    std::vector<Blob> blobs = {makeBlob(1, 80.0f, 16.0f, 5.0f)};
+    renderer.render(*shaders.getMetaballShader(), blobs);
+
+    EXPECT_GT(alphaAt(80, 16), 0);
+    EXPECT_EQ(alphaAt(80, 47), 0); // Y is down, like the tile rects
+    EXPECT_EQ(alphaAt(112, 16), 0);
+
+    blobs[0].setPosition(sf::Vector2f(112.0f, 16.0f));
+    renderer.render(*shaders.getMetaballShader(), blobs);
+
+    EXPECT_EQ(renderer.getLastFrameStats().tilesEvaluated, 2u);
+    EXPECT_EQ(alphaAt(80, 16), 0);
+    EXPECT_GT(alphaAt(112, 16), 0);
+}
+
+TEST_F(MetaballRendererTest, BlobsPastTheShaderLimitAreIgnored) {
+    std::vector<Blob> blobs;
+    for (std::uint32_t i = 0; i < MetaballRenderer::MAX_BLOBS; ++i) {
+        blobs.push_back(makeBlob(i + 1, 16.0f, 16.0f, 5.0f));
+    }
+    blobs.push_back(makeBlob(1000, 112.0f, 48.0f, 5.0f));
+    renderer.render(*shaders.getMetaballShader(), blobs);
+
+    EXPECT_GT(alphaAt(16, 16), 0);
+    EXPECT_EQ(alphaAt(112, 48), 0);
+
+    // Moving it doesn't dirty any tiles either
+    blobs.back().setPosition(sf::Vector2f(80.0f, 48.0f));
+    renderer.render(*shaders.getMetaballShader(), blobs);
+    EXPECT_EQ(renderer.getLastFrameStats().tilesEvaluated, 0u);
+}